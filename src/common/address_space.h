@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/free_range_allocator.h"
 
 namespace Common {
 template <typename VaType, size_t AddressSpaceBits>
@@ -107,7 +108,7 @@ private:
 
 /**
  * @brief FlatMemoryManager specialises FlatAddressSpaceMap to work as an allocator, with an
- * initial, fast linear pass and a subsequent slower pass that iterates until it finds a free block
+ * initial linear pass and a subsequent segregated-fit search of the free ranges
  */
 template <typename VaType, VaType UnmappedVa, size_t AddressSpaceBits>
     requires AddressSpaceValid<VaType, AddressSpaceBits>
@@ -138,6 +139,14 @@ public:
         return virt_start;
     }
 
+    /**
+     * @brief Summarises how the free space of the AS is split
+     */
+    FragmentationReport GetFragmentationReport() {
+        std::scoped_lock lock(this->block_mutex);
+        return free_ranges.GetFragmentationReport();
+    }
+
 private:
     /// The base VA of the allocator, no allocations will be below this
     VaType virt_start;
@@ -147,5 +156,8 @@ private:
      * Once this reaches the AS limit the slower allocation path will be used
      */
     VaType current_linear_alloc_end;
+
+    /// The unallocated regions of the AS, kept in sync with the block map
+    FreeRangeAllocator<VaType> free_ranges;
 };
 } // namespace Common
@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Summary of how the free space of an allocator is split
+struct FragmentationReport {
+    /// Total size of the free ranges
+    u64 free_size;
+    /// Size of the largest free range
+    u64 largest_free_size;
+    /// Number of disjoint free ranges
+    size_t num_free_ranges;
+
+    /// Fraction of the free space outside of the largest free range, zero when it is contiguous
+    [[nodiscard]] double Fragmentation() const noexcept {
+        if (free_size == 0) {
+            return 0.0;
+        }
+        return 1.0 - static_cast<double>(largest_free_size) / static_cast<double>(free_size);
+    }
+};
+
+/// Segregated-fit allocator of address ranges.
+/// Free ranges are coalesced when they are freed and binned by size class. A two level bitmap of
+/// the non-empty bins finds the smallest class guaranteed to fit a request in constant time, and
+/// each bin hands out its lowest addressed range first.
+template <std::unsigned_integral T>
+class FreeRangeAllocator {
+public:
+    /// Marks [begin, end) as free, merging it with the free ranges it overlaps or touches.
+    /// Returns the resulting free range containing it.
+    std::pair<T, T> Free(T begin, T end) {
+        if (begin >= end) {
+            return {begin, end};
+        }
+        auto it = ranges.upper_bound(begin);
+        if (it != ranges.begin() && std::prev(it)->second >= begin) {
+            --it;
+        }
+        if (it == ranges.end() || it->first > end) {
+            InsertRange(begin, end);
+            return {begin, end};
+        }
+        // Grow the first range touching [begin, end) over the ones after it, reusing its nodes
+        const auto first = it;
+        for (++it; it != ranges.end() && it->first <= end;) {
+            end = std::max(end, it->second);
+            it = EraseRange(it);
+        }
+        begin = std::min(begin, first->first);
+        end = std::max(end, first->second);
+        ResizeRange(first, begin, end);
+        return {begin, end};
+    }
+
+    /// Removes [begin, end) from the free ranges, splitting the ranges it partially covers
+    void Reserve(T begin, T end) {
+        if (begin >= end) {
+            return;
+        }
+        auto it = ranges.upper_bound(begin);
+        if (it != ranges.begin() && std::prev(it)->second > begin) {
+            --it;
+        }
+        while (it != ranges.end() && it->first < end) {
+            const T range_begin = it->first;
+            const T range_end = it->second;
+            if (range_begin < begin) {
+                // Keep the head of the range and split off its tail if it is not covered
+                ResizeRange(it, range_begin, begin);
+                if (range_end > end) {
+                    InsertRange(end, range_end);
+                    return;
+                }
+                ++it;
+            } else if (range_end > end) {
+                ResizeRange(it, end, range_end);
+                return;
+            } else {
+                it = EraseRange(it);
+            }
+        }
+    }
+
+    /// Finds and reserves size contiguous units, returns the first one
+    [[nodiscard]] std::optional<T> Allocate(T size) {
+        const std::optional<T> begin = FindFit(size);
+        if (begin) {
+            Reserve(*begin, *begin + size);
+        }
+        return begin;
+    }
+
+    /// Returns where size contiguous units can be allocated without reserving them
+    [[nodiscard]] std::optional<T> FindFit(T size) const {
+        if (size == 0) {
+            return std::nullopt;
+        }
+        // Every range in the bins at or above the rounded up size class fits the request
+        const T granularity_mask = (T{1} << BinShift(size)) - 1;
+        if (size <= std::numeric_limits<T>::max() - granularity_mask) {
+            const std::optional<size_t> bin = FindNonEmptyBin(BinIndex(size + granularity_mask));
+            if (bin) {
+                return bins[*bin].begin()->first;
+            }
+        }
+        // Fall back to the ranges sharing the size class of the request, some of them may fit
+        for (const auto& [begin, end] : bins[BinIndex(size)]) {
+            if (end - begin >= size) {
+                return begin;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Returns how many free units start at addr, zero when addr is not free
+    [[nodiscard]] T FreeSizeAt(T addr) const {
+        auto it = ranges.upper_bound(addr);
+        if (it == ranges.begin()) {
+            return 0;
+        }
+        --it;
+        return it->second > addr ? it->second - addr : 0;
+    }
+
+    [[nodiscard]] FragmentationReport GetFragmentationReport() const {
+        FragmentationReport report{};
+        for (const auto& [begin, end] : ranges) {
+            report.free_size += end - begin;
+            report.largest_free_size = std::max<u64>(report.largest_free_size, end - begin);
+        }
+        report.num_free_ranges = ranges.size();
+        return report;
+    }
+
+private:
+    static constexpr size_t SECOND_LEVEL_BITS = 4;
+    static constexpr size_t SECOND_LEVEL_COUNT = size_t{1} << SECOND_LEVEL_BITS;
+    static constexpr size_t FIRST_LEVEL_COUNT = std::numeric_limits<T>::digits;
+
+    /// Returns the log2 of the size granularity of the class of size
+    [[nodiscard]] static size_t BinShift(T size) noexcept {
+        const size_t first_level = std::bit_width(size) - 1;
+        return first_level > SECOND_LEVEL_BITS ? first_level - SECOND_LEVEL_BITS : 0;
+    }
+
+    /// Returns the bin of a non-zero size, the first level is its log2 and the second level
+    /// splits the sizes sharing it linearly
+    [[nodiscard]] static size_t BinIndex(T size) noexcept {
+        const size_t first_level = std::bit_width(size) - 1;
+        const size_t shift = BinShift(size);
+        const size_t second_level =
+            static_cast<size_t>(size >> shift) - (size_t{1} << (first_level - shift));
+        return first_level * SECOND_LEVEL_COUNT + second_level;
+    }
+
+    /// Returns the first non-empty bin at or above index
+    [[nodiscard]] std::optional<size_t> FindNonEmptyBin(size_t index) const noexcept {
+        size_t first_level = index / SECOND_LEVEL_COUNT;
+        u32 second_level_map = second_level_bitmaps[first_level] &
+                               (~u32{0} << (index % SECOND_LEVEL_COUNT));
+        if (second_level_map == 0) {
+            if (first_level + 1 >= FIRST_LEVEL_COUNT) {
+                return std::nullopt;
+            }
+            const u64 first_level_map = first_level_bitmap & (~u64{0} << (first_level + 1));
+            if (first_level_map == 0) {
+                return std::nullopt;
+            }
+            first_level = static_cast<size_t>(std::countr_zero(first_level_map));
+            second_level_map = second_level_bitmaps[first_level];
+        }
+        return first_level * SECOND_LEVEL_COUNT +
+               static_cast<size_t>(std::countr_zero(second_level_map));
+    }
+
+    using RangeIterator = typename std::map<T, T>::iterator;
+    using BinNode = typename std::set<std::pair<T, T>>::node_type;
+
+    void InsertRange(T begin, T end) {
+        ranges.emplace(begin, end);
+        InsertBinNode(begin, end, BinNode{});
+    }
+
+    RangeIterator EraseRange(RangeIterator it) {
+        ExtractBinNode(it->first, it->second);
+        return ranges.erase(it);
+    }
+
+    /// Changes the bounds of a free range, moving its nodes instead of allocating new ones
+    void ResizeRange(RangeIterator it, T begin, T end) {
+        InsertBinNode(begin, end, ExtractBinNode(it->first, it->second));
+        if (it->first == begin) {
+            it->second = end;
+            return;
+        }
+        auto node = ranges.extract(it);
+        node.key() = begin;
+        node.mapped() = end;
+        ranges.insert(std::move(node));
+    }
+
+    void InsertBinNode(T begin, T end, BinNode&& node) {
+        const size_t index = BinIndex(end - begin);
+        if (node) {
+            node.value() = {begin, end};
+            bins[index].insert(std::move(node));
+        } else {
+            bins[index].emplace(begin, end);
+        }
+        second_level_bitmaps[index / SECOND_LEVEL_COUNT] |= u32{1} << (index % SECOND_LEVEL_COUNT);
+        first_level_bitmap |= u64{1} << (index / SECOND_LEVEL_COUNT);
+    }
+
+    BinNode ExtractBinNode(T begin, T end) {
+        const size_t index = BinIndex(end - begin);
+        auto& bin = bins[index];
+        BinNode node = bin.extract({begin, end});
+        if (bin.empty()) {
+            const size_t first_level = index / SECOND_LEVEL_COUNT;
+            second_level_bitmaps[first_level] &= ~(u32{1} << (index % SECOND_LEVEL_COUNT));
+            if (second_level_bitmaps[first_level] == 0) {
+                first_level_bitmap &= ~(u64{1} << first_level);
+            }
+        }
+        return node;
+    }
+
+    std::map<T, T> ranges;
+    std::array<std::set<std::pair<T, T>>, FIRST_LEVEL_COUNT * SECOND_LEVEL_COUNT> bins;
+    std::array<u32, FIRST_LEVEL_COUNT> second_level_bitmaps{};
+    u64 first_level_bitmap{};
+};
+
+} // namespace Common
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <mutex>
-#include <boost/icl/interval_set.hpp>
+#include <utility>
+
+#include "common/free_range_allocator.h"
 
 namespace Common {
 
@@ -20,36 +23,30 @@ public:
     std::pair<void*, size_t> FreeBlock(void* block_ptr, size_t size) {
         std::scoped_lock lk(m_mutex);
 
-        // Check to see if we are adjacent to any regions.
-        auto start_address = reinterpret_cast<uintptr_t>(block_ptr);
-        auto end_address = start_address + size;
-        auto it = m_free_regions.find({start_address - 1, end_address + 1});
-
-        // If we are, join with them, ensuring we stay in bounds.
-        if (it != m_free_regions.end()) {
-            start_address = std::min(start_address, it->lower());
-            end_address = std::max(end_address, it->upper());
-        }
-
-        // Free the relevant region.
-        m_free_regions.insert({start_address, end_address});
+        // Free the relevant region, joining it with any adjacent region.
+        const auto start_address = reinterpret_cast<uintptr_t>(block_ptr);
+        const auto [merged_start, merged_end] =
+            m_free_regions.Free(start_address, start_address + size);
 
         // Return the adjusted pointers.
-        block_ptr = reinterpret_cast<void*>(start_address);
-        size = end_address - start_address;
-        return {block_ptr, size};
+        return {reinterpret_cast<void*>(merged_start), merged_end - merged_start};
     }
 
     void AllocateBlock(void* block_ptr, size_t size) {
         std::scoped_lock lk(m_mutex);
 
         auto address = reinterpret_cast<uintptr_t>(block_ptr);
-        m_free_regions.subtract({address, address + size});
+        m_free_regions.Reserve(address, address + size);
+    }
+
+    FragmentationReport GetFragmentationReport() {
+        std::scoped_lock lk(m_mutex);
+        return m_free_regions.GetFragmentationReport();
     }
 
 private:
     std::mutex m_mutex;
-    boost::icl::interval_set<uintptr_t> m_free_regions;
+    FreeRangeAllocator<uintptr_t> m_free_regions;
 };
 
 } // namespace Common
@@ -18,6 +18,7 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/random.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include "common/scope_exit.h"
 
@@ -28,10 +29,12 @@
 #endif // ^^^ Linux ^^^
 
 #include <mutex>
+#include <optional>
 #include <random>
 
 #include "common/alignment.h"
 #include "common/assert.h"
+#include "common/free_range_allocator.h"
 #include "common/free_region_manager.h"
 #include "common/host_memory.h"
 #include "common/logging/log.h"
@@ -194,6 +197,10 @@ public:
         return false;
     }
 
+    std::optional<size_t> CommittedBackingSize() const {
+        return std::nullopt;
+    }
+
     void EnableDirectMappedAddress() {
         // TODO
         UNREACHABLE();
@@ -551,6 +558,13 @@ public:
 
     bool ClearBackingRegion(size_t physical_offset, size_t length) {
 #ifdef __linux__
+        // Punch a hole in the backing file to return its pages to the host. Mappings of the hole
+        // read as zeroes and only commit memory again when they are written.
+        if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                      static_cast<off_t>(physical_offset), static_cast<off_t>(length)) == 0) {
+            return true;
+        }
+
         // Set MADV_REMOVE on backing map to destroy it instantly.
         // This also deletes the area from the backing file.
         int ret = madvise(backing_base + physical_offset, length, MADV_REMOVE);
@@ -562,6 +576,17 @@ public:
 #endif
     }
 
+    std::optional<size_t> CommittedBackingSize() const {
+#ifdef __linux__
+        // Blocks of the memfd are allocated on first write and freed when holes are punched
+        struct stat st {};
+        if (fstat(fd, &st) == 0) {
+            return static_cast<size_t>(st.st_blocks) * 512;
+        }
+#endif
+        return std::nullopt;
+    }
+
     void EnableDirectMappedAddress() {
         virtual_base = nullptr;
     }
@@ -637,6 +662,10 @@ public:
         return false;
     }
 
+    std::optional<size_t> CommittedBackingSize() const {
+        return std::nullopt;
+    }
+
     void EnableDirectMappedAddress() {}
 
     u8* backing_base{nullptr};
@@ -645,8 +674,18 @@ public:
 
 #endif // ^^^ Generic ^^^
 
+/// Ranges of the backing memory known to read as zeroes without committing host memory
+struct HostMemory::ReleasedRanges {
+    std::mutex mutex;
+    FreeRangeAllocator<size_t> ranges;
+};
+
 HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_)
-    : backing_size(backing_size_), virtual_size(virtual_size_) {
+    : backing_size(backing_size_), virtual_size(virtual_size_),
+      released_ranges{std::make_unique<ReleasedRanges>()} {
+    // Freshly allocated backing memory is zero filled and committed on first write.
+    released_ranges->ranges.Free(0, backing_size);
+
     try {
         // Try to allocate a fastmem arena.
         // The implementation will fail with std::bad_alloc on errors.
@@ -715,11 +754,45 @@ void HostMemory::Protect(size_t virtual_offset, size_t length, MemoryPermission
 }
 
 void HostMemory::ClearBackingRegion(size_t physical_offset, size_t length, u32 fill_value) {
+    bool is_released{};
+    {
+        // Only the tracker is shared, the region itself is owned by the caller
+        std::scoped_lock lk{released_ranges->mutex};
+        auto& ranges = released_ranges->ranges;
+        is_released = ranges.FreeSizeAt(physical_offset) >= length;
+        ranges.Reserve(physical_offset, physical_offset + length);
+    }
+    if (fill_value == 0 && is_released) {
+        // Released memory already reads as zeroes, leave it uncommitted until it is written.
+        return;
+    }
     if (!impl || fill_value != 0 || !impl->ClearBackingRegion(physical_offset, length)) {
         std::memset(backing_base + physical_offset, fill_value, length);
     }
 }
 
+void HostMemory::ReleaseBackingRegion(size_t physical_offset, size_t length) {
+    ASSERT(physical_offset + length <= backing_size);
+    const bool is_released = impl && impl->ClearBackingRegion(physical_offset, length);
+    std::scoped_lock lk{released_ranges->mutex};
+    if (is_released) {
+        released_ranges->ranges.Free(physical_offset, physical_offset + length);
+    } else {
+        // The region may have been written since it was allocated, so it keeps its contents.
+        released_ranges->ranges.Reserve(physical_offset, physical_offset + length);
+    }
+}
+
+size_t HostMemory::GetCommittedBackingSize() const {
+    if (impl) {
+        if (const auto committed_size = impl->CommittedBackingSize()) {
+            return *committed_size;
+        }
+    }
+    std::scoped_lock lk{released_ranges->mutex};
+    return backing_size - released_ranges->ranges.GetFragmentationReport().free_size;
+}
+
 void HostMemory::EnableDirectMappedAddress() {
     if (impl) {
         impl->EnableDirectMappedAddress();
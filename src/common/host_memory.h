@@ -49,8 +49,23 @@ public:
 
     void EnableDirectMappedAddress();
 
+    /// Fills a backing region before it is reused. Zero fills of released regions are deferred
+    /// to the host, which commits their pages again when they are first written.
     void ClearBackingRegion(size_t physical_offset, size_t length, u32 fill_value);
 
+    /// Returns the pages of a backing region that is no longer in use to the host.
+    /// The contents of the region are discarded and read as zeroes afterwards.
+    void ReleaseBackingRegion(size_t physical_offset, size_t length);
+
+    /// Returns the size of the backing memory committed by the host. Hosts that can't report it
+    /// get an estimate of the regions that may hold data, which excludes released regions.
+    [[nodiscard]] size_t GetCommittedBackingSize() const;
+
+    /// Returns the size of the backing memory reserved in the address space
+    [[nodiscard]] size_t GetBackingSize() const noexcept {
+        return backing_size;
+    }
+
     [[nodiscard]] u8* BackingBasePointer() noexcept {
         return backing_base;
     }
@@ -76,6 +91,8 @@ private:
     // Low level handler for the platform dependent memory routines
     class Impl;
     std::unique_ptr<Impl> impl;
+    struct ReleasedRanges;
+    std::unique_ptr<ReleasedRanges> released_ranges;
     u8* backing_base{};
     u8* virtual_base{};
     size_t virtual_base_offset{};
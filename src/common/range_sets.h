@@ -23,6 +23,11 @@ public:
 
     void Add(AddressType base_address, size_t size);
     void Subtract(AddressType base_address, size_t size);
+
+    /// Subtracts every range of other in a single pass
+    void Subtract(const RangeSet& other);
+
+    /// Removes all ranges, keeping the allocated storage for reuse
     void Clear();
     bool Empty() const;
 
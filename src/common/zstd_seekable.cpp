@@ -0,0 +1,278 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <zdict.h>
+#include <zstd.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/logging/log.h"
+#include "common/zstd_seekable.h"
+
+namespace Common::Compression {
+namespace {
+// Layout of the seek table defined by the zstd seekable format
+constexpr u32 SKIPPABLE_FRAME_MAGIC = 0x184D2A5E;
+constexpr u32 SEEKABLE_MAGIC = 0x8F92EAB1;
+constexpr size_t SKIPPABLE_HEADER_SIZE = 8;
+constexpr size_t SEEK_ENTRY_SIZE = 8;
+constexpr size_t SEEK_ENTRY_WITH_CHECKSUM_SIZE = 12;
+constexpr size_t SEEK_TABLE_FOOTER_SIZE = 9;
+constexpr u8 CHECKSUM_FLAG = 0x80;
+
+template <typename T>
+void WriteValue(std::vector<u8>& output, T value) {
+    const size_t offset = output.size();
+    output.resize(offset + sizeof(value));
+    std::memcpy(output.data() + offset, &value, sizeof(value));
+}
+
+template <typename T>
+T ReadAt(std::span<const u8> data, size_t offset) {
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+void FreeCompressionContext(ZSTD_CCtx* context) {
+    ZSTD_freeCCtx(context);
+}
+
+void FreeDecompressionContext(ZSTD_DCtx* context) {
+    ZSTD_freeDCtx(context);
+}
+} // Anonymous namespace
+
+ZSTDDictionary ZSTDDictionary::Train(std::span<const std::span<const u8>> samples,
+                                     size_t max_size) {
+    std::vector<u8> samples_buffer;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (const std::span<const u8> sample : samples) {
+        samples_buffer.insert(samples_buffer.end(), sample.begin(), sample.end());
+        sample_sizes.push_back(sample.size());
+    }
+    std::vector<u8> dictionary(max_size);
+    const size_t dictionary_size =
+        ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples_buffer.data(),
+                              sample_sizes.data(), static_cast<unsigned>(sample_sizes.size()));
+    if (ZDICT_isError(dictionary_size)) {
+        LOG_WARNING(Common, "Failed to train compression dictionary: {}",
+                    ZDICT_getErrorName(dictionary_size));
+        return {};
+    }
+    dictionary.resize(dictionary_size);
+    return ZSTDDictionary{std::move(dictionary)};
+}
+
+SeekableZSTDWriter::SeekableZSTDWriter(Sink sink_, s32 compression_level, u32 num_threads,
+                                       const ZSTDDictionary* dictionary)
+    : sink{std::move(sink_)}, context{ZSTD_createCCtx(), FreeCompressionContext} {
+    compression_level = std::clamp(compression_level, 1, ZSTD_maxCLevel());
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, compression_level);
+    if (num_threads > 0 &&
+        ZSTD_isError(ZSTD_CCtx_setParameter(context.get(), ZSTD_c_nbWorkers,
+                                            static_cast<int>(num_threads)))) {
+        // zstd was built without threading support, compress on the calling thread
+        LOG_DEBUG(Common, "Multithreaded compression is not supported");
+    }
+    if (dictionary && !dictionary->IsEmpty()) {
+        const auto data = dictionary->Data();
+        ZSTD_CCtx_loadDictionary(context.get(), data.data(), data.size());
+    }
+}
+
+SeekableZSTDWriter::~SeekableZSTDWriter() = default;
+
+bool SeekableZSTDWriter::Append(std::span<const u8> record) {
+    if (is_finished || record.size() > std::numeric_limits<u32>::max()) {
+        return false;
+    }
+    frame.resize(ZSTD_compressBound(record.size()));
+    const size_t compressed_size =
+        ZSTD_compress2(context.get(), frame.data(), frame.size(), record.data(), record.size());
+    if (ZSTD_isError(compressed_size)) {
+        LOG_ERROR(Common, "Failed to compress record: {}", ZSTD_getErrorName(compressed_size));
+        return false;
+    }
+    if (!sink(std::span(frame.data(), compressed_size))) {
+        return false;
+    }
+    entries.push_back(SeekEntry{
+        .compressed_size = static_cast<u32>(compressed_size),
+        .decompressed_size = static_cast<u32>(record.size()),
+    });
+    return true;
+}
+
+bool SeekableZSTDWriter::Finish() {
+    if (is_finished) {
+        return false;
+    }
+    is_finished = true;
+
+    const size_t table_size = entries.size() * SEEK_ENTRY_SIZE + SEEK_TABLE_FOOTER_SIZE;
+    frame.clear();
+    frame.reserve(SKIPPABLE_HEADER_SIZE + table_size);
+    WriteValue(frame, SKIPPABLE_FRAME_MAGIC);
+    WriteValue(frame, static_cast<u32>(table_size));
+    for (const SeekEntry& entry : entries) {
+        WriteValue(frame, entry.compressed_size);
+        WriteValue(frame, entry.decompressed_size);
+    }
+    WriteValue(frame, static_cast<u32>(entries.size()));
+    WriteValue(frame, u8{0});
+    WriteValue(frame, SEEKABLE_MAGIC);
+    return sink(frame);
+}
+
+SeekableZSTDReader::SeekableZSTDReader(std::span<const u8> archive_,
+                                       const ZSTDDictionary* dictionary)
+    : archive{archive_}, context{ZSTD_createDCtx(), FreeDecompressionContext} {
+    Initialize(dictionary);
+}
+
+SeekableZSTDReader::SeekableZSTDReader(const std::filesystem::path& path,
+                                       const ZSTDDictionary* dictionary)
+    : context{ZSTD_createDCtx(), FreeDecompressionContext} {
+#ifdef _WIN32
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER file_size{};
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            // The view keeps the mapping alive after its handles are closed
+            mapped_base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            mapped_size = static_cast<size_t>(file_size.QuadPart);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        void* const base = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ,
+                                MAP_PRIVATE, fd, 0);
+        if (base != MAP_FAILED) {
+            mapped_base = base;
+            mapped_size = static_cast<size_t>(file_stat.st_size);
+        }
+    }
+    close(fd);
+#endif
+    if (!mapped_base) {
+        mapped_size = 0;
+        return;
+    }
+    archive = std::span(static_cast<const u8*>(mapped_base), mapped_size);
+    Initialize(dictionary);
+}
+
+SeekableZSTDReader::~SeekableZSTDReader() {
+    Unmap();
+}
+
+void SeekableZSTDReader::Initialize(const ZSTDDictionary* dictionary) {
+    if (archive.size() < SKIPPABLE_HEADER_SIZE + SEEK_TABLE_FOOTER_SIZE) {
+        return;
+    }
+    const size_t footer_offset = archive.size() - SEEK_TABLE_FOOTER_SIZE;
+    const u32 num_frames = ReadAt<u32>(archive, footer_offset);
+    const u8 descriptor = ReadAt<u8>(archive, footer_offset + 4);
+    if (ReadAt<u32>(archive, footer_offset + 5) != SEEKABLE_MAGIC) {
+        return;
+    }
+    const size_t entry_size =
+        (descriptor & CHECKSUM_FLAG) != 0 ? SEEK_ENTRY_WITH_CHECKSUM_SIZE : SEEK_ENTRY_SIZE;
+    const size_t table_size = static_cast<size_t>(num_frames) * entry_size;
+    if (table_size > footer_offset - SKIPPABLE_HEADER_SIZE) {
+        return;
+    }
+    const size_t table_offset = footer_offset - table_size;
+    const size_t frame_header_offset = table_offset - SKIPPABLE_HEADER_SIZE;
+    if (ReadAt<u32>(archive, frame_header_offset) != SKIPPABLE_FRAME_MAGIC ||
+        ReadAt<u32>(archive, frame_header_offset + 4) != table_size + SEEK_TABLE_FOOTER_SIZE) {
+        return;
+    }
+    records.reserve(num_frames);
+    u64 offset = 0;
+    for (size_t index = 0; index < num_frames; ++index) {
+        const size_t entry_offset = table_offset + index * entry_size;
+        const Record record{
+            .offset = offset,
+            .compressed_size = ReadAt<u32>(archive, entry_offset),
+            .decompressed_size = ReadAt<u32>(archive, entry_offset + 4),
+        };
+        offset += record.compressed_size;
+        records.push_back(record);
+    }
+    if (offset != frame_header_offset) {
+        // Frames don't add up to the seek table, the archive is truncated or corrupted
+        records.clear();
+        return;
+    }
+    if (dictionary && !dictionary->IsEmpty()) {
+        const auto data = dictionary->Data();
+        ZSTD_DCtx_loadDictionary(context.get(), data.data(), data.size());
+    }
+    is_valid = true;
+}
+
+void SeekableZSTDReader::Unmap() {
+    if (!mapped_base) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapped_base);
+#else
+    munmap(mapped_base, mapped_size);
+#endif
+    mapped_base = nullptr;
+    mapped_size = 0;
+}
+
+bool SeekableZSTDReader::Read(size_t index, std::span<u8> output) {
+    if (!is_valid || index >= records.size()) {
+        return false;
+    }
+    const Record& record = records[index];
+    if (output.size() < record.decompressed_size) {
+        return false;
+    }
+    const size_t result =
+        ZSTD_decompressDCtx(context.get(), output.data(), record.decompressed_size,
+                            archive.data() + record.offset, record.compressed_size);
+    return !ZSTD_isError(result) && result == record.decompressed_size;
+}
+
+std::vector<u8> SeekableZSTDReader::Read(size_t index) {
+    if (!is_valid || index >= records.size()) {
+        return {};
+    }
+    std::vector<u8> output(records[index].decompressed_size);
+    if (!Read(index, output)) {
+        return {};
+    }
+    return output;
+}
+
+} // namespace Common::Compression
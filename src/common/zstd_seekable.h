@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace Common::Compression {
+
+/// Zstandard dictionary shared by the writer and the reader of an archive.
+/// Trained dictionaries shrink archives of many small records with a common structure, like shader
+/// environments, far more than compressing each record on its own.
+class ZSTDDictionary {
+public:
+    ZSTDDictionary() = default;
+    explicit ZSTDDictionary(std::vector<u8> data_) : data{std::move(data_)} {}
+
+    /**
+     * Trains a dictionary from samples of the records that will be compressed with it.
+     *
+     * @param samples  Sample records, training needs at least a few dozen of them.
+     * @param max_size Maximum size of the dictionary in bytes.
+     *
+     * @return the trained dictionary, or an empty dictionary when training failed.
+     */
+    [[nodiscard]] static ZSTDDictionary Train(std::span<const std::span<const u8>> samples,
+                                              size_t max_size);
+
+    [[nodiscard]] std::span<const u8> Data() const noexcept {
+        return data;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return data.empty();
+    }
+
+private:
+    std::vector<u8> data;
+};
+
+/// Writes a seekable Zstandard archive. Every record is compressed as an independent frame and
+/// Finish appends a seek table in a skippable frame, following the zstd seekable format, so
+/// readers can decompress any record without touching the others.
+class SeekableZSTDWriter {
+public:
+    /// Receives the compressed bytes in order, returns false when they couldn't be written
+    using Sink = std::function<bool(std::span<const u8>)>;
+
+    /**
+     * @param sink              Destination of the archive bytes, e.g. a file.
+     * @param compression_level The used compression level. Should be between 1 and 22.
+     * @param num_threads       Worker threads used to compress large records, 0 compresses on the
+     *                          calling thread. Ignored when zstd was built without threading.
+     * @param dictionary        Optional dictionary, readers have to use the same one.
+     */
+    explicit SeekableZSTDWriter(Sink sink, s32 compression_level, u32 num_threads = 0,
+                                const ZSTDDictionary* dictionary = nullptr);
+    ~SeekableZSTDWriter();
+
+    YUZU_NON_COPYABLE(SeekableZSTDWriter);
+    YUZU_NON_MOVEABLE(SeekableZSTDWriter);
+
+    /// Compresses a record into its own frame and writes it, returns false on failure
+    bool Append(std::span<const u8> record);
+
+    /// Writes the seek table, no record can be appended afterwards. Returns false on failure.
+    bool Finish();
+
+private:
+    struct SeekEntry {
+        u32 compressed_size;
+        u32 decompressed_size;
+    };
+
+    Sink sink;
+    std::unique_ptr<ZSTD_CCtx_s, void (*)(ZSTD_CCtx_s*)> context;
+    std::vector<u8> frame;
+    std::vector<SeekEntry> entries;
+    bool is_finished{};
+};
+
+/// Reads the records of a seekable Zstandard archive kept in memory or mapped from disk.
+/// Reading decompresses straight into caller buffers. A reader is not thread safe, concurrent
+/// readers of the same archive each need their own instance.
+class SeekableZSTDReader {
+public:
+    /// Reads an archive in memory, the memory has to outlive the reader
+    explicit SeekableZSTDReader(std::span<const u8> archive,
+                                const ZSTDDictionary* dictionary = nullptr);
+
+    /// Maps an archive file into memory for the lifetime of the reader
+    explicit SeekableZSTDReader(const std::filesystem::path& path,
+                                const ZSTDDictionary* dictionary = nullptr);
+
+    ~SeekableZSTDReader();
+
+    YUZU_NON_COPYABLE(SeekableZSTDReader);
+    YUZU_NON_MOVEABLE(SeekableZSTDReader);
+
+    /// Returns true when the archive and its seek table have been read successfully
+    [[nodiscard]] bool IsValid() const noexcept {
+        return is_valid;
+    }
+
+    [[nodiscard]] size_t NumRecords() const noexcept {
+        return records.size();
+    }
+
+    /// Returns the decompressed size of a record
+    [[nodiscard]] size_t RecordSize(size_t index) const noexcept {
+        return records[index].decompressed_size;
+    }
+
+    /// Decompresses a record into a buffer of at least RecordSize bytes, returns false on failure
+    bool Read(size_t index, std::span<u8> output);
+
+    /// Decompresses a record into a new vector, returns an empty vector on failure
+    [[nodiscard]] std::vector<u8> Read(size_t index);
+
+private:
+    struct Record {
+        u64 offset;
+        u32 compressed_size;
+        u32 decompressed_size;
+    };
+
+    void Initialize(const ZSTDDictionary* dictionary);
+
+    void Unmap();
+
+    std::span<const u8> archive;
+    void* mapped_base{};
+    size_t mapped_size{};
+
+    std::unique_ptr<ZSTD_DCtx_s, void (*)(ZSTD_DCtx_s*)> context;
+    std::vector<Record> records;
+    bool is_valid{};
+};
+
+} // namespace Common::Compression
@@ -480,7 +480,10 @@ struct System::Impl {
     }
 
     PerfStatsResults GetAndResetPerfStats() {
-        return perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
+        PerfStatsResults results = perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
+        results.committed_memory = device_memory->buffer.GetCommittedBackingSize();
+        results.reserved_memory = device_memory->buffer.GetBackingSize();
+        return results;
     }
 
     mutable std::mutex suspend_guard;
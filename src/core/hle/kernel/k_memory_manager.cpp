@@ -2,6 +2,9 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <utility>
+
+#include <boost/container/small_vector.hpp>
 
 #include "common/alignment.h"
 #include "common/assert.h"
@@ -430,6 +433,43 @@ Result KMemoryManager::AllocateForProcess(KPageGroup* out, size_t num_pages, u32
     R_SUCCEED();
 }
 
+void KMemoryManager::Close(KPhysicalAddress address, size_t num_pages) {
+    // Repeatedly close references until we've done so for all pages.
+    while (num_pages) {
+        auto& manager = this->GetManager(address);
+        const size_t cur_pages = std::min(num_pages, manager.GetPageOffsetToEnd(address));
+        auto& pool_lock = m_pool_locks[static_cast<size_t>(manager.GetPool())];
+
+        // Pages left without references can't be opened again until they are freed, so their
+        // backing memory is released outside of the pool lock before returning them to the heap.
+        boost::container::small_vector<std::pair<KPhysicalAddress, size_t>, 8> unreferenced;
+        {
+            KScopedLightLock lk(pool_lock);
+            manager.Close(address, cur_pages, [&](KPhysicalAddress addr, size_t pages) {
+                unreferenced.emplace_back(addr, pages);
+            });
+        }
+        if (!unreferenced.empty()) {
+            for (const auto& [addr, pages] : unreferenced) {
+                this->ReleaseBacking(addr, pages);
+            }
+
+            KScopedLightLock lk(pool_lock);
+            for (const auto& [addr, pages] : unreferenced) {
+                manager.Free(addr, pages);
+            }
+        }
+
+        num_pages -= cur_pages;
+        address += cur_pages * PageSize;
+    }
+}
+
+void KMemoryManager::ReleaseBacking(KPhysicalAddress address, size_t num_pages) {
+    m_system.DeviceMemory().buffer.ReleaseBackingRegion(
+        GetInteger(address) - Core::DramMemoryMap::Base, num_pages * PageSize);
+}
+
 size_t KMemoryManager::Impl::Initialize(KPhysicalAddress address, size_t size,
                                         KVirtualAddress management, KVirtualAddress management_end,
                                         Pool p) {
@@ -514,6 +554,18 @@ bool KMemoryManager::Impl::ProcessOptimizedAllocation(KernelCore& kernel, KPhysi
     size_t offset = this->GetPageOffset(block);
     const size_t last = offset + num_pages - 1;
 
+    // Fill runs of new pages through the backing memory, so released pages are tracked again.
+    const size_t heap_offset = GetInteger(m_heap.GetAddress()) - Core::DramMemoryMap::Base;
+    size_t fill_start = 0;
+    size_t fill_count = 0;
+    const auto fill = [&] {
+        if (fill_count > 0) {
+            device_memory.buffer.ClearBackingRegion(heap_offset + fill_start * PageSize,
+                                                    fill_count * PageSize, fill_pattern);
+            fill_count = 0;
+        }
+    };
+
     // Process.
     while (offset <= last) {
         // Check if the page has been optimized-allocated before.
@@ -523,12 +575,17 @@ bool KMemoryManager::Impl::ProcessOptimizedAllocation(KernelCore& kernel, KPhysi
             any_new = true;
 
             // Fill the page.
-            auto* ptr = device_memory.GetPointer<u8>(m_heap.GetAddress());
-            std::memset(ptr + offset * PageSize, fill_pattern, PageSize);
+            if (fill_count == 0) {
+                fill_start = offset;
+            }
+            fill_count++;
+        } else {
+            fill();
         }
 
         offset++;
     }
+    fill();
 
     // Return the number of pages we processed.
     return any_new;
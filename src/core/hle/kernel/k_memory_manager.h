@@ -96,21 +96,7 @@ public:
         }
     }
 
-    void Close(KPhysicalAddress address, size_t num_pages) {
-        // Repeatedly close references until we've done so for all pages.
-        while (num_pages) {
-            auto& manager = this->GetManager(address);
-            const size_t cur_pages = std::min(num_pages, manager.GetPageOffsetToEnd(address));
-
-            {
-                KScopedLightLock lk(m_pool_locks[static_cast<size_t>(manager.GetPool())]);
-                manager.Close(address, cur_pages);
-            }
-
-            num_pages -= cur_pages;
-            address += cur_pages * PageSize;
-        }
-    }
+    void Close(KPhysicalAddress address, size_t num_pages);
 
     size_t GetSize() {
         size_t total = 0;
@@ -285,7 +271,10 @@ private:
             }
         }
 
-        void Close(KPhysicalAddress address, size_t num_pages) {
+        /// Drops a reference to the pages, calling on_unreferenced for each run of pages left
+        /// without references. The caller is responsible for freeing them.
+        template <typename OnUnreferenced>
+        void Close(KPhysicalAddress address, size_t num_pages, OnUnreferenced&& on_unreferenced) {
             size_t index = this->GetPageOffset(address);
             const size_t end = index + num_pages;
 
@@ -305,7 +294,7 @@ private:
                     }
                 } else {
                     if (free_count > 0) {
-                        this->Free(m_heap.GetAddress() + free_start * PageSize, free_count);
+                        on_unreferenced(m_heap.GetAddress() + free_start * PageSize, free_count);
                         free_count = 0;
                     }
                 }
@@ -314,7 +303,7 @@ private:
             }
 
             if (free_count > 0) {
-                this->Free(m_heap.GetAddress() + free_start * PageSize, free_count);
+                on_unreferenced(m_heap.GetAddress() + free_start * PageSize, free_count);
             }
         }
 
@@ -330,6 +319,9 @@ private:
     };
 
 private:
+    /// Gives the host memory backing freed pages back, they read as zeroes until reused
+    void ReleaseBacking(KPhysicalAddress address, size_t num_pages);
+
     Impl& GetManager(KPhysicalAddress address) {
         return m_managers[m_memory_layout.GetPhysicalLinearRegion(address).GetAttributes()];
     }
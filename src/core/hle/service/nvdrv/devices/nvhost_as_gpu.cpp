@@ -173,6 +173,10 @@ NvResult nvhost_as_gpu::AllocateSpace(IoctlAllocSpace& params) {
     } else {
         params.offset = static_cast<u64>(allocator.Allocate(params.pages)) << page_size_bits;
         if (!params.offset) {
+            const auto report{allocator.GetFragmentationReport()};
+            LOG_ERROR(Service_NVDRV,
+                      "GPU AS exhausted: {} free pages in {} ranges, largest range {} pages",
+                      report.free_size, report.num_free_ranges, report.largest_free_size);
             ASSERT_MSG(false, "Failed to allocate free space in the GPU AS!");
             return NvResult::InsufficientMemory;
         }
@@ -394,6 +398,10 @@ NvResult nvhost_as_gpu::MapBufferEx(IoctlMapBufferEx& params) {
                             static_cast<u32>(Common::AlignUp(size, page_size) >> page_size_bits)))
                         << page_size_bits;
         if (!params.offset) {
+            const auto report{allocator.GetFragmentationReport()};
+            LOG_ERROR(Service_NVDRV,
+                      "GPU AS exhausted: {} free pages in {} ranges, largest range {} pages",
+                      report.free_size, report.num_free_ranges, report.largest_free_size);
             ASSERT_MSG(false, "Failed to allocate free space in the GPU AS!");
             return NvResult::InsufficientMemory;
         }
@@ -21,6 +21,10 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Guest physical memory backed by committed host memory, in bytes. May be an estimate.
+    u64 committed_memory;
+    /// Guest physical memory reserved in the host address space, in bytes
+    u64 reserved_memory;
 };
 
 /**
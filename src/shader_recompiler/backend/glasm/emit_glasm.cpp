@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <iterator>
 #include <string>
 #include <tuple>
 
@@ -458,7 +459,7 @@ std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, I
     }
     header += "TEMP ";
     for (size_t index = 0; index < ctx.reg_alloc.NumUsedRegisters(); ++index) {
-        header += fmt::format("R{},", index);
+        fmt::format_to(std::back_inserter(header), "R{},", index);
     }
     if (program.local_memory_size > 0) {
         header += fmt::format("lmem[{}],", Common::DivCeil(program.local_memory_size, 4U));
@@ -468,12 +469,12 @@ std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, I
     }
     const u32 num_safety_loop_vectors{Common::DivCeil(ctx.num_safety_loop_vars, 4u)};
     for (u32 index = 0; index < num_safety_loop_vectors; ++index) {
-        header += fmt::format("loop{},", index);
+        fmt::format_to(std::back_inserter(header), "loop{},", index);
     }
     header += "RC;"
               "LONG TEMP ";
     for (size_t index = 0; index < ctx.reg_alloc.NumUsedLongRegisters(); ++index) {
-        header += fmt::format("D{},", index);
+        fmt::format_to(std::back_inserter(header), "D{},", index);
     }
     header += "DC;";
     if (program.info.uses_fswzadd) {
@@ -487,7 +488,8 @@ std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, I
                   "MOV.F FSWZB[3],-1;";
     }
     for (u32 index = 0; index < num_safety_loop_vectors; ++index) {
-        header += fmt::format("MOV.S loop{},{{0x2000,0x2000,0x2000,0x2000}};", index);
+        fmt::format_to(std::back_inserter(header), "MOV.S loop{},{{0x2000,0x2000,0x2000,0x2000}};",
+                       index);
     }
     if (ctx.uses_y_direction) {
         header += "PARAM y_direction[1]={state.material.front.ambient};";
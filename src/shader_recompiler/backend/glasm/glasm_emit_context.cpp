@@ -22,6 +22,17 @@ std::string_view InterpDecorator(Interpolation interp) {
     throw InvalidArgument("Invalid interpolation {}", interp);
 }
 
+size_t EstimatedCodeSize(const IR::Program& program) {
+    // Rough average of emitted characters per IR instruction, reserved upfront to avoid
+    // regrowing the code buffer while emitting
+    constexpr size_t CHARS_PER_INST{32};
+    size_t num_insts{};
+    for (const IR::Block* const block : program.blocks) {
+        num_insts += block->size();
+    }
+    return num_insts * CHARS_PER_INST;
+}
+
 bool IsInputArray(Stage stage) {
     return stage == Stage::Geometry || stage == Stage::TessellationControl ||
            stage == Stage::TessellationEval;
@@ -31,6 +42,7 @@ bool IsInputArray(Stage stage) {
 EmitContext::EmitContext(IR::Program& program, Bindings& bindings, const Profile& profile_,
                          const RuntimeInfo& runtime_info_)
     : info{program.info}, profile{profile_}, runtime_info{runtime_info_} {
+    code.reserve(EstimatedCodeSize(program));
     // FIXME: Temporary partial implementation
     u32 cbuf_index{};
     for (const auto& desc : info.constant_buffer_descriptors) {
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <iterator>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -200,16 +201,16 @@ void DefineVariables(const EmitContext& ctx, std::string& header) {
         const auto precise{!has_precise_bug && IsPreciseType(type) ? "precise " : ""};
         // Temps/return types that are never used are stored at index 0
         if (tracker.uses_temp) {
-            header += fmt::format("{}{} t{}={}(0);", precise, type_name,
-                                  ctx.var_alloc.Representation(0, type), type_name);
+            fmt::format_to(std::back_inserter(header), "{}{} {}={}(0);", precise, type_name,
+                           tracker.temp_name, type_name);
         }
         for (u32 index = 0; index < tracker.num_used; ++index) {
-            header += fmt::format("{}{} {}={}(0);", precise, type_name,
-                                  ctx.var_alloc.Representation(index, type), type_name);
+            fmt::format_to(std::back_inserter(header), "{}{} {}={}(0);", precise, type_name,
+                           tracker.names[index], type_name);
         }
     }
     for (u32 i = 0; i < ctx.num_safety_loop_vars; ++i) {
-        header += fmt::format("int loop{}=0x2000;", i);
+        fmt::format_to(std::back_inserter(header), "int loop{}=0x2000;", i);
     }
 }
 } // Anonymous namespace
@@ -62,6 +62,17 @@ std::string OutputDecorator(Stage stage, u32 size) {
     }
 }
 
+size_t EstimatedCodeSize(const IR::Program& program) {
+    // Rough average of emitted characters per IR instruction, reserved upfront to avoid
+    // regrowing the code buffer while emitting
+    constexpr size_t CHARS_PER_INST{24};
+    size_t num_insts{};
+    for (const IR::Block* const block : program.blocks) {
+        num_insts += block->size();
+    }
+    return num_insts * CHARS_PER_INST;
+}
+
 std::string_view DepthSamplerType(TextureType type) {
     switch (type) {
     case TextureType::Color1D:
@@ -272,6 +283,7 @@ EmitContext::EmitContext(IR::Program& program, Bindings& bindings, const Profile
     : info{program.info}, profile{profile_}, runtime_info{runtime_info_}, stage{program.stage},
       uses_geometry_passthrough{program.is_geometry_passthrough &&
                                 profile.support_geometry_shader_passthrough} {
+    code.reserve(EstimatedCodeSize(program));
     if (profile.need_fastmath_off) {
         header += "#pragma optionNV(fastmath off)\n";
     }
@@ -369,6 +381,21 @@ EmitContext::EmitContext(IR::Program& program, Bindings& bindings, const Profile
     DefineConstants();
 }
 
+void EmitContext::AddDefinition(GlslVarType type, fmt::string_view format_str, IR::Inst& inst,
+                                fmt::format_args args) {
+    // Definitions are formatted as "{}=...", the variable name is written directly and the
+    // remainder of the format string is emitted with the instruction arguments
+    format_str.remove_prefix(3);
+    const auto var_def{var_alloc.AddDefine(inst, type)};
+    if (!var_def.empty()) {
+        code += var_def;
+        code += '=';
+    }
+    fmt::vformat_to(std::back_inserter(code), format_str, args);
+    // TODO: Remove this
+    code += '\n';
+}
+
 void EmitContext::SetupExtensions() {
     header += "#extension GL_ARB_separate_shader_objects : enable\n";
     if (info.uses_shadow_lod && profile.support_gl_texture_shadow_lod) {
@@ -93,50 +93,57 @@ std::string MakeImm(const IR::Value& value) {
 }
 } // Anonymous namespace
 
-std::string VarAlloc::Representation(u32 index, GlslVarType type) const {
-    const auto prefix{TypePrefix(type)};
-    return fmt::format("{}{}", prefix, index);
+std::string_view VarAlloc::Representation(u32 index, GlslVarType type) const {
+    const auto& names{GetUseTracker(type).names};
+    if (index >= names.size()) {
+        throw LogicError("Variable {} of type {} has not been allocated", index, type);
+    }
+    return names[index];
 }
 
-std::string VarAlloc::Representation(Id id) const {
+std::string_view VarAlloc::Representation(Id id) const {
     return Representation(id.index, id.type);
 }
 
-std::string VarAlloc::Define(IR::Inst& inst, GlslVarType type) {
+std::string_view VarAlloc::Define(IR::Inst& inst, GlslVarType type) {
     if (inst.HasUses()) {
         inst.SetDefinition<Id>(Alloc(type));
         return Representation(inst.Definition<Id>());
     } else {
         Id id{};
         id.type.Assign(type);
-        GetUseTracker(type).uses_temp = true;
+        auto& use_tracker{GetUseTracker(type)};
+        if (!use_tracker.uses_temp) {
+            use_tracker.uses_temp = true;
+            use_tracker.temp_name = fmt::format("t{}0", TypePrefix(type));
+        }
         inst.SetDefinition<Id>(id);
-        return 't' + Representation(inst.Definition<Id>());
+        return use_tracker.temp_name;
     }
 }
 
-std::string VarAlloc::Define(IR::Inst& inst, IR::Type type) {
+std::string_view VarAlloc::Define(IR::Inst& inst, IR::Type type) {
     return Define(inst, RegType(type));
 }
 
-std::string VarAlloc::PhiDefine(IR::Inst& inst, IR::Type type) {
+std::string_view VarAlloc::PhiDefine(IR::Inst& inst, IR::Type type) {
     return AddDefine(inst, RegType(type));
 }
 
-std::string VarAlloc::AddDefine(IR::Inst& inst, GlslVarType type) {
+std::string_view VarAlloc::AddDefine(IR::Inst& inst, GlslVarType type) {
     if (inst.HasUses()) {
         inst.SetDefinition<Id>(Alloc(type));
         return Representation(inst.Definition<Id>());
     } else {
-        return "";
+        return {};
     }
 }
 
 std::string VarAlloc::Consume(const IR::Value& value) {
-    return value.IsImmediate() ? MakeImm(value) : ConsumeInst(*value.InstRecursive());
+    return value.IsImmediate() ? MakeImm(value) : std::string{ConsumeInst(*value.InstRecursive())};
 }
 
-std::string VarAlloc::ConsumeInst(IR::Inst& inst) {
+std::string_view VarAlloc::ConsumeInst(IR::Inst& inst) {
     inst.DestructiveRemoveUsage();
     if (!inst.HasUses()) {
         Free(inst.Definition<Id>());
@@ -163,8 +170,9 @@ Id VarAlloc::Alloc(GlslVarType type) {
         ret.index.Assign(static_cast<u32>(var));
         return ret;
     }
-    // Allocate a new variable
+    // Allocate a new variable and intern its name
     use_tracker.var_use.push_back(true);
+    use_tracker.names.push_back(fmt::format("{}{}", TypePrefix(type), use_tracker.num_used));
     Id ret{};
     ret.is_valid.Assign(1);
     ret.type.Assign(type);
@@ -12,6 +12,7 @@
 
 #include "common/common_types.h"
 #include "common/div_ceil.h"
+#include "common/settings.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
 #include "shader_recompiler/backend/spirv/spirv_emit_context.h"
 
@@ -197,12 +198,11 @@ Id GetAttributeType(EmitContext& ctx, AttributeType type) {
     case AttributeType::Float:
         return ctx.F32[4];
     case AttributeType::SignedInt:
-        return ctx.TypeVector(ctx.TypeInt(32, true), 4);
+        return ctx.S32[4];
     case AttributeType::UnsignedInt:
         return ctx.U32[4];
     case AttributeType::SignedScaled:
-        return ctx.profile.support_scaled_attributes ? ctx.F32[4]
-                                                     : ctx.TypeVector(ctx.TypeInt(32, true), 4);
+        return ctx.profile.support_scaled_attributes ? ctx.F32[4] : ctx.S32[4];
     case AttributeType::UnsignedScaled:
         return ctx.profile.support_scaled_attributes ? ctx.F32[4] : ctx.U32[4];
     case AttributeType::Disabled:
@@ -218,13 +218,11 @@ InputGenericInfo GetAttributeInfo(EmitContext& ctx, AttributeType type, Id id) {
     case AttributeType::UnsignedInt:
         return InputGenericInfo{id, ctx.input_u32, ctx.U32[1], InputGenericLoadOp::Bitcast};
     case AttributeType::SignedInt:
-        return InputGenericInfo{id, ctx.input_s32, ctx.TypeInt(32, true),
-                                InputGenericLoadOp::Bitcast};
+        return InputGenericInfo{id, ctx.input_s32, ctx.S32[1], InputGenericLoadOp::Bitcast};
     case AttributeType::SignedScaled:
         return ctx.profile.support_scaled_attributes
                    ? InputGenericInfo{id, ctx.input_f32, ctx.F32[1], InputGenericLoadOp::None}
-                   : InputGenericInfo{id, ctx.input_s32, ctx.TypeInt(32, true),
-                                      InputGenericLoadOp::SToF};
+                   : InputGenericInfo{id, ctx.input_s32, ctx.S32[1], InputGenericLoadOp::SToF};
     case AttributeType::UnsignedScaled:
         return ctx.profile.support_scaled_attributes
                    ? InputGenericInfo{id, ctx.input_f32, ctx.F32[1], InputGenericLoadOp::None}
@@ -442,16 +440,15 @@ Id DescType(EmitContext& ctx, Id sampled_type, Id pointer_type, u32 count) {
 }
 } // Anonymous namespace
 
-void VectorTypes::Define(Sirit::Module& sirit_ctx, Id base_type, std::string_view name) {
-    defs[0] = sirit_ctx.Name(base_type, name);
+void VectorTypes::Define(EmitContext& ctx, Id base_type, std::string_view name) {
+    defs[0] = ctx.Name(base_type, name);
 
     std::array<char, 6> def_name;
     for (int i = 1; i < 4; ++i) {
         const std::string_view def_name_view(
             def_name.data(),
             fmt::format_to_n(def_name.data(), def_name.size(), "{}x{}", name, i + 1).size);
-        defs[static_cast<size_t>(i)] =
-            sirit_ctx.Name(sirit_ctx.TypeVector(base_type, i + 1), def_name_view);
+        defs[static_cast<size_t>(i)] = ctx.Name(ctx.TypeVector(base_type, i + 1), def_name_view);
     }
 }
 
@@ -459,13 +456,15 @@ EmitContext::EmitContext(const Profile& profile_, const RuntimeInfo& runtime_inf
                          IR::Program& program, Bindings& bindings)
     : Sirit::Module(profile_.supported_spirv), profile{profile_}, runtime_info{runtime_info_},
       stage{program.stage}, texture_rescaling_index{bindings.texture_scaling_index},
-      image_rescaling_index{bindings.image_scaling_index} {
+      image_rescaling_index{bindings.image_scaling_index},
+      emit_debug_names{Settings::values.renderer_debug.GetValue()} {
     const bool is_unified{profile.unified_descriptor_binding};
     u32& uniform_binding{is_unified ? bindings.unified : bindings.uniform_buffer};
     u32& storage_binding{is_unified ? bindings.unified : bindings.storage_buffer};
     u32& texture_binding{is_unified ? bindings.unified : bindings.texture};
     u32& image_binding{is_unified ? bindings.unified : bindings.image};
     AddCapability(spv::Capability::Shader);
+    ReserveConstants(program);
     DefineCommonTypes(program.info);
     DefineCommonConstants();
     DefineInterfaces(program);
@@ -488,6 +487,20 @@ EmitContext::EmitContext(const Profile& profile_, const RuntimeInfo& runtime_inf
 
 EmitContext::~EmitContext() = default;
 
+Id EmitContext::Name(Id target, std::string_view name) {
+    if (emit_debug_names) {
+        Sirit::Module::Name(target, name);
+    }
+    return target;
+}
+
+Id EmitContext::MemberName(Id type, u32 member, std::string_view name) {
+    if (emit_debug_names) {
+        Sirit::Module::MemberName(type, member, name);
+    }
+    return type;
+}
+
 Id EmitContext::Def(const IR::Value& value) {
     if (!value.IsImmediate()) {
         return value.InstRecursive()->Definition<Id>();
@@ -526,6 +539,28 @@ Id EmitContext::BitOffset16(const IR::Value& offset) {
     return OpBitwiseAnd(U32[1], OpShiftLeftLogical(U32[1], Def(offset), Const(3u)), Const(16u));
 }
 
+void EmitContext::ReserveConstants(const IR::Program& program) {
+    // Size the constant tables from the immediates in the program, an upper bound of the number
+    // of distinct constants, so they are not rehashed while emitting
+    size_t num_u32{};
+    size_t num_f32{};
+    for (const IR::Block* const block : program.blocks) {
+        for (const IR::Inst& inst : block->Instructions()) {
+            const size_t num_args{inst.NumArgs()};
+            for (size_t arg_index = 0; arg_index < num_args; ++arg_index) {
+                const IR::Value arg{inst.Arg(arg_index)};
+                if (!arg.IsImmediate()) {
+                    continue;
+                }
+                num_u32 += arg.Type() == IR::Type::U32 ? 1 : 0;
+                num_f32 += arg.Type() == IR::Type::F32 ? 1 : 0;
+            }
+        }
+    }
+    u32_constants.reserve(num_u32);
+    f32_constants.reserve(num_f32);
+}
+
 void EmitContext::DefineCommonTypes(const Info& info) {
     void_id = TypeVoid();
 
@@ -535,11 +570,9 @@ void EmitContext::DefineCommonTypes(const Info& info) {
     U32.Define(*this, TypeInt(32, false), "u32");
     S32.Define(*this, TypeInt(32, true), "s32");
 
-    private_u32 = Name(TypePointer(spv::StorageClass::Private, U32[1]), "private_u32");
-
     input_f32 = Name(TypePointer(spv::StorageClass::Input, F32[1]), "input_f32");
     input_u32 = Name(TypePointer(spv::StorageClass::Input, U32[1]), "input_u32");
-    input_s32 = Name(TypePointer(spv::StorageClass::Input, TypeInt(32, true)), "input_s32");
+    input_s32 = Name(TypePointer(spv::StorageClass::Input, S32[1]), "input_s32");
 
     output_f32 = Name(TypePointer(spv::StorageClass::Output, F32[1]), "output_f32");
     output_u32 = Name(TypePointer(spv::StorageClass::Output, U32[1]), "output_u32");
@@ -584,6 +617,8 @@ void EmitContext::DefineLocalMemory(const IR::Program& program) {
     if (program.local_memory_size == 0) {
         return;
     }
+    private_u32 = Name(TypePointer(spv::StorageClass::Private, U32[1]), "private_u32");
+
     const u32 num_elements{Common::DivCeil(program.local_memory_size, 4U)};
     const Id type{TypeArray(U32[1], Const(num_elements))};
     const Id pointer{TypePointer(spv::StorageClass::Private, type)};
@@ -4,9 +4,12 @@
 #pragma once
 
 #include <array>
+#include <string_view>
+#include <unordered_map>
 
 #include <sirit/sirit.h>
 
+#include "common/bit_cast.h"
 #include "shader_recompiler/backend/bindings.h"
 #include "shader_recompiler/frontend/ir/program.h"
 #include "shader_recompiler/profile.h"
@@ -17,9 +20,11 @@ namespace Shader::Backend::SPIRV {
 
 using Sirit::Id;
 
+class EmitContext;
+
 class VectorTypes {
 public:
-    void Define(Sirit::Module& sirit_ctx, Id base_type, std::string_view name);
+    void Define(EmitContext& ctx, Id base_type, std::string_view name);
 
     [[nodiscard]] Id operator[](size_t size) const noexcept {
         return defs[size - 1];
@@ -164,8 +169,12 @@ public:
     [[nodiscard]] Id BitOffset8(const IR::Value& offset);
     [[nodiscard]] Id BitOffset16(const IR::Value& offset);
 
+    /// Debug names are only emitted when debugging the renderer, they inflate the module otherwise
+    Id Name(Id target, std::string_view name);
+    Id MemberName(Id type, u32 member, std::string_view name);
+
     Id Const(u32 value) {
-        return Constant(U32[1], value);
+        return InternConstant(u32_constants, value, U32[1], value);
     }
 
     Id Const(u32 element_1, u32 element_2) {
@@ -182,7 +191,7 @@ public:
     }
 
     Id SConst(s32 value) {
-        return Constant(S32[1], value);
+        return InternConstant(s32_constants, static_cast<u32>(value), S32[1], value);
     }
 
     Id SConst(s32 element_1, s32 element_2) {
@@ -199,7 +208,8 @@ public:
     }
 
     Id Const(f32 value) {
-        return Constant(F32[1], value);
+        // Keyed by the bit pattern, so negative zero and NaNs get their own constants
+        return InternConstant(f32_constants, Common::BitCast<u32>(value), F32[1], value);
     }
 
     const Profile& profile;
@@ -383,6 +393,23 @@ private:
 
     void DefineInputs(const IR::Program& program);
     void DefineOutputs(const IR::Program& program);
+
+    void ReserveConstants(const IR::Program& program);
+
+    template <typename T>
+    Id InternConstant(std::unordered_map<u32, Id>& constants, u32 key, Id type, T value) {
+        // Sirit deduplicates declarations too, but only after encoding and hashing them
+        const auto [it, is_new]{constants.try_emplace(key)};
+        if (is_new) {
+            it->second = Constant(type, value);
+        }
+        return it->second;
+    }
+
+    bool emit_debug_names{};
+    std::unordered_map<u32, Id> u32_constants;
+    std::unordered_map<u32, Id> s32_constants;
+    std::unordered_map<u32, Id> f32_constants;
 };
 
 } // namespace Shader::Backend::SPIRV
@@ -0,0 +1,591 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+
+#include "common/bit_cast.h"
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/frontend/ir/serialization.h"
+
+namespace Shader::IR {
+namespace {
+constexpr u32 NUM_OPCODES{static_cast<u32>(std::size(Detail::META_TABLE))};
+constexpr u32 NULL_INDEX{~0U};
+
+class Writer {
+public:
+    template <typename... Ts>
+    void Pod(const Ts&... values) {
+        (PodOne(values), ...);
+    }
+
+    template <size_t N>
+    void Bits(const std::bitset<N>& bits) {
+        for (size_t word = 0; word < N; word += 64) {
+            u64 value{};
+            for (size_t bit = word; bit < std::min(N, word + 64); ++bit) {
+                value |= static_cast<u64>(bits[bit]) << (bit - word);
+            }
+            PodOne(value);
+        }
+    }
+
+    template <typename Container>
+    void Range(const Container& container) {
+        PodOne(static_cast<u32>(container.size()));
+        for (const auto& element : container) {
+            PodOne(element);
+        }
+    }
+
+    template <typename Key, typename Mapped>
+    void Map(const std::map<Key, Mapped>& map) {
+        PodOne(static_cast<u32>(map.size()));
+        for (const auto& [key, mapped] : map) {
+            Pod(key, mapped);
+        }
+    }
+
+    [[nodiscard]] std::vector<u8>& Data() noexcept {
+        return data;
+    }
+
+private:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void PodOne(const T& value) {
+        const u8* const bytes{reinterpret_cast<const u8*>(&value)};
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    std::vector<u8> data;
+};
+
+class Reader {
+public:
+    explicit Reader(std::span<const u8> data_) : data{data_} {}
+
+    template <typename... Ts>
+    void Pod(Ts&... values) {
+        (PodOne(values), ...);
+    }
+
+    template <typename T>
+    [[nodiscard]] T Read() {
+        T value{};
+        PodOne(value);
+        return value;
+    }
+
+    template <size_t N>
+    void Bits(std::bitset<N>& bits) {
+        for (size_t word = 0; word < N; word += 64) {
+            const u64 value{Read<u64>()};
+            for (size_t bit = word; bit < std::min(N, word + 64); ++bit) {
+                bits[bit] = ((value >> (bit - word)) & 1) != 0;
+            }
+        }
+    }
+
+    template <typename Container>
+    void Range(Container& container) {
+        const u32 size{ReadCount(sizeof(typename Container::value_type))};
+        if (size > container.max_size()) {
+            failed = true;
+            return;
+        }
+        container.resize(size);
+        for (auto& element : container) {
+            PodOne(element);
+        }
+    }
+
+    template <typename Key, typename Mapped>
+    void Map(std::map<Key, Mapped>& map) {
+        const u32 size{ReadCount(sizeof(Key) + sizeof(Mapped))};
+        for (u32 index = 0; index < size; ++index) {
+            const Key key{Read<Key>()};
+            map.insert_or_assign(key, Read<Mapped>());
+        }
+    }
+
+    /// Reads an element count, failing when the remaining data can't hold that many elements
+    [[nodiscard]] u32 ReadCount(size_t element_size) {
+        const u32 count{Read<u32>()};
+        if (static_cast<u64>(count) * element_size > data.size() - offset) {
+            failed = true;
+            return 0;
+        }
+        return count;
+    }
+
+    [[nodiscard]] bool Failed() const noexcept {
+        return failed;
+    }
+
+    [[nodiscard]] bool AtEnd() const noexcept {
+        return offset == data.size();
+    }
+
+    void Fail() noexcept {
+        failed = true;
+    }
+
+private:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void PodOne(T& value) {
+        if (failed || data.size() - offset < sizeof(T)) {
+            failed = true;
+            return;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+    }
+
+    std::span<const u8> data;
+    size_t offset{};
+    bool failed{};
+};
+
+/// Visits every member of the shader info, used to both serialize and deserialize it
+template <typename Archive, typename InfoType>
+void VisitInfo(Archive& ar, InfoType& info) {
+    ar.Pod(info.uses_workgroup_id, info.uses_local_invocation_id, info.uses_invocation_id,
+           info.uses_invocation_info, info.uses_sample_id, info.uses_is_helper_invocation,
+           info.uses_subgroup_invocation_id, info.uses_subgroup_shuffles, info.uses_patches,
+           info.interpolation);
+    ar.Bits(info.loads.mask);
+    ar.Bits(info.stores.mask);
+    ar.Bits(info.passthrough.mask);
+    ar.Map(info.legacy_stores_mapping);
+    ar.Pod(info.loads_indexed_attributes, info.stores_frag_color, info.stores_sample_mask,
+           info.stores_frag_depth, info.stores_tess_level_outer, info.stores_tess_level_inner,
+           info.stores_indexed_attributes, info.stores_global_memory, info.uses_local_memory,
+           info.uses_fp16, info.uses_fp64, info.uses_fp16_denorms_flush,
+           info.uses_fp16_denorms_preserve, info.uses_fp32_denorms_flush,
+           info.uses_fp32_denorms_preserve, info.uses_int8, info.uses_int16, info.uses_int64,
+           info.uses_image_1d, info.uses_sampled_1d, info.uses_sparse_residency,
+           info.uses_demote_to_helper_invocation, info.uses_subgroup_vote,
+           info.uses_subgroup_mask, info.uses_fswzadd, info.uses_derivatives,
+           info.uses_typeless_image_reads, info.uses_typeless_image_writes,
+           info.uses_image_buffers, info.uses_shared_increment, info.uses_shared_decrement,
+           info.uses_global_increment, info.uses_global_decrement, info.uses_atomic_f32_add,
+           info.uses_atomic_f16x2_add, info.uses_atomic_f16x2_min, info.uses_atomic_f16x2_max,
+           info.uses_atomic_f32x2_add, info.uses_atomic_f32x2_min, info.uses_atomic_f32x2_max,
+           info.uses_atomic_s32_min, info.uses_atomic_s32_max, info.uses_int64_bit_atomics,
+           info.uses_global_memory, info.uses_atomic_image_u32, info.uses_shadow_lod,
+           info.uses_rescaling_uniform, info.uses_cbuf_indirect, info.uses_render_area,
+           info.used_constant_buffer_types, info.used_storage_buffer_types,
+           info.used_indirect_cbuf_types, info.constant_buffer_mask,
+           info.constant_buffer_used_sizes, info.nvn_buffer_base);
+    ar.Bits(info.nvn_buffer_used);
+    ar.Pod(info.requires_layer_emulation, info.emulated_layer, info.used_clip_distances);
+    ar.Range(info.constant_buffer_descriptors);
+    ar.Range(info.storage_buffers_descriptors);
+    ar.Range(info.texture_buffer_descriptors);
+    ar.Range(info.image_buffer_descriptors);
+    ar.Range(info.texture_descriptors);
+    ar.Range(info.image_descriptors);
+}
+
+u64 ImmediateBits(const Value& value) {
+    switch (value.Type()) {
+    case Type::Reg:
+        return static_cast<u64>(value.Reg());
+    case Type::Pred:
+        return static_cast<u64>(value.Pred());
+    case Type::Attribute:
+        return static_cast<u64>(value.Attribute());
+    case Type::Patch:
+        return static_cast<u64>(value.Patch());
+    case Type::U1:
+        return value.U1() ? 1 : 0;
+    case Type::U8:
+        return value.U8();
+    case Type::U16:
+        return value.U16();
+    case Type::U32:
+        return value.U32();
+    case Type::F32:
+        return Common::BitCast<u32>(value.F32());
+    case Type::U64:
+        return value.U64();
+    case Type::F64:
+        return Common::BitCast<u64>(value.F64());
+    default:
+        throw NotImplementedException("Serializing immediate of type {}", value.Type());
+    }
+}
+
+std::optional<Value> MakeImmediate(Type type, u64 bits) {
+    switch (type) {
+    case Type::Void:
+        return Value{};
+    case Type::Reg:
+        return Value{static_cast<IR::Reg>(bits)};
+    case Type::Pred:
+        return Value{static_cast<IR::Pred>(bits)};
+    case Type::Attribute:
+        return Value{static_cast<IR::Attribute>(bits)};
+    case Type::Patch:
+        return Value{static_cast<IR::Patch>(bits)};
+    case Type::U1:
+        return Value{bits != 0};
+    case Type::U8:
+        return Value{static_cast<u8>(bits)};
+    case Type::U16:
+        return Value{static_cast<u16>(bits)};
+    case Type::U32:
+        return Value{static_cast<u32>(bits)};
+    case Type::F32:
+        return Value{Common::BitCast<f32>(static_cast<u32>(bits))};
+    case Type::U64:
+        return Value{bits};
+    case Type::F64:
+        return Value{Common::BitCast<f64>(bits)};
+    default:
+        return std::nullopt;
+    }
+}
+
+class ProgramWriter {
+public:
+    explicit ProgramWriter(const Program& program_) : program{program_} {
+        for (const Block* const block : program.blocks) {
+            block_indices.emplace(block, static_cast<u32>(block_indices.size()));
+            for (const Inst& inst : *block) {
+                inst_indices.emplace(&inst, static_cast<u32>(inst_indices.size()));
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<u8> Write() {
+        writer.Pod(SERIALIZED_PROGRAM_VERSION, NUM_OPCODES,
+                   static_cast<u32>(program.blocks.size()),
+                   static_cast<u32>(inst_indices.size()));
+        for (const Block* const block : program.blocks) {
+            writer.Pod(block->GetOrder(), static_cast<u32>(block->ImmSuccessors().size()));
+            for (const Block* const successor : block->ImmSuccessors()) {
+                WriteBlock(successor);
+            }
+            writer.Pod(static_cast<u32>(block->size()));
+            for (const Inst& inst : *block) {
+                writer.Pod(inst.GetOpcode(), inst.Flags<u32>());
+                if (inst.GetOpcode() == Opcode::Phi) {
+                    writer.Pod(static_cast<u32>(inst.NumArgs()));
+                }
+            }
+        }
+        // Arguments are written once every instruction has an index, phi nodes and condition
+        // references may point to instructions defined later in the list
+        for (const Block* const block : program.blocks) {
+            for (const Inst& inst : *block) {
+                const size_t num_args{inst.NumArgs()};
+                for (size_t index = 0; index < num_args; ++index) {
+                    if (inst.GetOpcode() == Opcode::Phi) {
+                        WriteBlock(inst.PhiBlock(index));
+                    }
+                    WriteValue(inst.Arg(index));
+                }
+            }
+        }
+        writer.Pod(static_cast<u32>(program.post_order_blocks.size()));
+        for (const Block* const block : program.post_order_blocks) {
+            WriteBlock(block);
+        }
+        writer.Pod(static_cast<u32>(program.syntax_list.size()));
+        for (const AbstractSyntaxNode& node : program.syntax_list) {
+            WriteNode(node);
+        }
+        writer.Pod(program.stage, program.workgroup_size, program.output_topology,
+                   program.output_vertices, program.invocations, program.local_memory_size,
+                   program.shared_memory_size, program.is_geometry_passthrough);
+        VisitInfo(writer, program.info);
+        return std::move(writer.Data());
+    }
+
+private:
+    void WriteBlock(const Block* block) {
+        if (!block) {
+            writer.Pod(NULL_INDEX);
+            return;
+        }
+        const auto it{block_indices.find(block)};
+        if (it == block_indices.end()) {
+            throw LogicError("Block is not in the program");
+        }
+        writer.Pod(it->second);
+    }
+
+    void WriteValue(const Value& value) {
+        if (value.IsEmpty()) {
+            writer.Pod(Type::Void);
+            return;
+        }
+        if (!value.IsIdentity() && value.IsImmediate()) {
+            writer.Pod(value.Type(), ImmediateBits(value));
+            return;
+        }
+        // Identities are kept, the program has to be rebuilt exactly as it was
+        const auto it{inst_indices.find(value.Inst())};
+        if (it == inst_indices.end()) {
+            throw LogicError("Instruction is not in the program");
+        }
+        writer.Pod(Type::Opaque, it->second);
+    }
+
+    void WriteNode(const AbstractSyntaxNode& node) {
+        const auto& data{node.data};
+        writer.Pod(node.type);
+        switch (node.type) {
+        case AbstractSyntaxNode::Type::Block:
+            WriteBlock(data.block);
+            break;
+        case AbstractSyntaxNode::Type::If:
+            WriteValue(data.if_node.cond);
+            WriteBlock(data.if_node.body);
+            WriteBlock(data.if_node.merge);
+            break;
+        case AbstractSyntaxNode::Type::EndIf:
+            WriteBlock(data.end_if.merge);
+            break;
+        case AbstractSyntaxNode::Type::Loop:
+            WriteBlock(data.loop.body);
+            WriteBlock(data.loop.continue_block);
+            WriteBlock(data.loop.merge);
+            break;
+        case AbstractSyntaxNode::Type::Repeat:
+            WriteValue(data.repeat.cond);
+            WriteBlock(data.repeat.loop_header);
+            WriteBlock(data.repeat.merge);
+            break;
+        case AbstractSyntaxNode::Type::Break:
+            WriteValue(data.break_node.cond);
+            WriteBlock(data.break_node.merge);
+            WriteBlock(data.break_node.skip);
+            break;
+        case AbstractSyntaxNode::Type::Return:
+        case AbstractSyntaxNode::Type::Unreachable:
+            break;
+        }
+    }
+
+    const Program& program;
+    std::unordered_map<const Block*, u32> block_indices;
+    std::unordered_map<const Inst*, u32> inst_indices;
+    Writer writer;
+};
+
+class ProgramReader {
+public:
+    explicit ProgramReader(ObjectPool<Inst>& inst_pool_, ObjectPool<Block>& block_pool_,
+                           std::span<const u8> data)
+        : inst_pool{inst_pool_}, block_pool{block_pool_}, reader{data} {}
+
+    [[nodiscard]] std::optional<Program> Read() {
+        const u32 version{reader.Read<u32>()};
+        const u32 num_opcodes{reader.Read<u32>()};
+        if (version != SERIALIZED_PROGRAM_VERSION || num_opcodes != NUM_OPCODES) {
+            return std::nullopt;
+        }
+        Program program;
+        ReadBlocks(program);
+        ReadArguments();
+        const u32 num_post_order_blocks{reader.ReadCount(sizeof(u32))};
+        program.post_order_blocks.reserve(num_post_order_blocks);
+        for (u32 index = 0; index < num_post_order_blocks; ++index) {
+            program.post_order_blocks.push_back(ReadBlock());
+        }
+        const u32 num_nodes{reader.ReadCount(sizeof(AbstractSyntaxNode::Type))};
+        program.syntax_list.reserve(num_nodes);
+        for (u32 index = 0; index < num_nodes && !reader.Failed(); ++index) {
+            program.syntax_list.push_back(ReadNode());
+        }
+        reader.Pod(program.stage, program.workgroup_size, program.output_topology,
+                   program.output_vertices, program.invocations, program.local_memory_size,
+                   program.shared_memory_size, program.is_geometry_passthrough);
+        VisitInfo(reader, program.info);
+        if (reader.Failed() || !reader.AtEnd()) {
+            return std::nullopt;
+        }
+        return program;
+    }
+
+private:
+    void ReadBlocks(Program& program) {
+        const u32 num_blocks{reader.ReadCount(sizeof(u32))};
+        const u32 num_insts{reader.Read<u32>()};
+        blocks.reserve(num_blocks);
+        for (u32 index = 0; index < num_blocks; ++index) {
+            blocks.push_back(block_pool.Create(inst_pool));
+        }
+        program.blocks = blocks;
+        insts.reserve(std::min<size_t>(num_insts, 1 << 16));
+        for (Block* const block : blocks) {
+            block->SetOrder(reader.Read<u32>());
+            const u32 num_successors{reader.ReadCount(sizeof(u32))};
+            for (u32 index = 0; index < num_successors; ++index) {
+                Block* const successor{ReadBlock()};
+                if (!successor) {
+                    reader.Fail();
+                    return;
+                }
+                block->AddBranch(successor);
+            }
+            const u32 block_size{reader.ReadCount(sizeof(Opcode) + sizeof(u32))};
+            for (u32 index = 0; index < block_size; ++index) {
+                const Opcode opcode{reader.Read<Opcode>()};
+                const u32 flags{reader.Read<u32>()};
+                if (static_cast<u32>(opcode) >= NUM_OPCODES || reader.Failed()) {
+                    reader.Fail();
+                    return;
+                }
+                Inst* const inst{inst_pool.Create(opcode, flags)};
+                block->Instructions().push_back(*inst);
+                insts.push_back(inst);
+                phi_sizes.push_back(opcode == Opcode::Phi ? reader.Read<u32>() : 0);
+            }
+        }
+        if (insts.size() != num_insts) {
+            reader.Fail();
+        }
+    }
+
+    void ReadArguments() {
+        for (size_t inst_index = 0; inst_index < insts.size() && !reader.Failed(); ++inst_index) {
+            Inst* const inst{insts[inst_index]};
+            if (inst->GetOpcode() == Opcode::Phi) {
+                for (u32 index = 0; index < phi_sizes[inst_index]; ++index) {
+                    Block* const predecessor{ReadBlock()};
+                    const Value value{ReadValue()};
+                    if (!predecessor || reader.Failed()) {
+                        reader.Fail();
+                        return;
+                    }
+                    inst->AddPhiOperand(predecessor, value);
+                }
+                continue;
+            }
+            const size_t num_args{inst->NumArgs()};
+            for (size_t index = 0; index < num_args; ++index) {
+                inst->SetArg(index, ReadValue());
+            }
+        }
+    }
+
+    Block* ReadBlock() {
+        const u32 index{reader.Read<u32>()};
+        if (index == NULL_INDEX) {
+            return nullptr;
+        }
+        if (index >= blocks.size()) {
+            reader.Fail();
+            return nullptr;
+        }
+        return blocks[index];
+    }
+
+    Value ReadValue() {
+        const Type type{reader.Read<Type>()};
+        if (type == Type::Opaque) {
+            const u32 index{reader.Read<u32>()};
+            if (index >= insts.size()) {
+                reader.Fail();
+                return Value{};
+            }
+            return Value{insts[index]};
+        }
+        const u64 bits{type == Type::Void ? 0 : reader.Read<u64>()};
+        const std::optional<Value> value{MakeImmediate(type, bits)};
+        if (!value) {
+            reader.Fail();
+            return Value{};
+        }
+        return *value;
+    }
+
+    U1 ReadCondition() {
+        const Value value{ReadValue()};
+        if (reader.Failed() || value.IsEmpty()) {
+            reader.Fail();
+            return U1{Value{false}};
+        }
+        return U1{value};
+    }
+
+    AbstractSyntaxNode ReadNode() {
+        AbstractSyntaxNode node{};
+        auto& data{node.data};
+        node.type = reader.Read<AbstractSyntaxNode::Type>();
+        switch (node.type) {
+        case AbstractSyntaxNode::Type::Block:
+            data.block = ReadBlock();
+            break;
+        case AbstractSyntaxNode::Type::If:
+            data.if_node.cond = ReadCondition();
+            data.if_node.body = ReadBlock();
+            data.if_node.merge = ReadBlock();
+            break;
+        case AbstractSyntaxNode::Type::EndIf:
+            data.end_if.merge = ReadBlock();
+            break;
+        case AbstractSyntaxNode::Type::Loop:
+            data.loop.body = ReadBlock();
+            data.loop.continue_block = ReadBlock();
+            data.loop.merge = ReadBlock();
+            break;
+        case AbstractSyntaxNode::Type::Repeat:
+            data.repeat.cond = ReadCondition();
+            data.repeat.loop_header = ReadBlock();
+            data.repeat.merge = ReadBlock();
+            break;
+        case AbstractSyntaxNode::Type::Break:
+            data.break_node.cond = ReadCondition();
+            data.break_node.merge = ReadBlock();
+            data.break_node.skip = ReadBlock();
+            break;
+        case AbstractSyntaxNode::Type::Return:
+        case AbstractSyntaxNode::Type::Unreachable:
+            break;
+        default:
+            reader.Fail();
+            break;
+        }
+        return node;
+    }
+
+    ObjectPool<Inst>& inst_pool;
+    ObjectPool<Block>& block_pool;
+    Reader reader;
+    std::vector<Block*> blocks;
+    std::vector<Inst*> insts;
+    std::vector<u32> phi_sizes;
+};
+} // Anonymous namespace
+
+std::vector<u8> SerializeProgram(const Program& program) {
+    try {
+        return ProgramWriter{program}.Write();
+    } catch (const Exception&) {
+        return {};
+    }
+}
+
+std::optional<Program> DeserializeProgram(ObjectPool<Inst>& inst_pool,
+                                          ObjectPool<Block>& block_pool,
+                                          std::span<const u8> data) {
+    try {
+        return ProgramReader{inst_pool, block_pool, data}.Read();
+    } catch (const Exception&) {
+        return std::nullopt;
+    }
+}
+
+} // namespace Shader::IR
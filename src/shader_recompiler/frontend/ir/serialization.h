@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/object_pool.h"
+
+namespace Shader::IR {
+
+/// Version of the serialized program format, bump it when the format changes
+constexpr u32 SERIALIZED_PROGRAM_VERSION{1};
+
+/// Serializes a program into a compact binary representation
+/// Returns an empty vector when the program references values outside of its blocks
+[[nodiscard]] std::vector<u8> SerializeProgram(const Program& program);
+
+/// Rebuilds a program from its serialized representation
+/// Returns an empty optional when the data is malformed or from a different IR revision
+[[nodiscard]] std::optional<Program> DeserializeProgram(ObjectPool<Inst>& inst_pool,
+                                                        ObjectPool<Block>& block_pool,
+                                                        std::span<const u8> data);
+
+} // namespace Shader::IR
@@ -9,6 +9,7 @@
 
 #include <fmt/format.h>
 
+#include "common/container_hash.h"
 #include "common/polyfill_ranges.h"
 #include "shader_recompiler/exception.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
@@ -188,6 +189,24 @@ CFG::CFG(Environment& env_, ObjectPool<Block>& block_pool_, Location start_addre
          bool exits_to_dispatcher_)
     : env{env_}, block_pool{block_pool_}, program_start{start_address}, exits_to_dispatcher{
                                                                             exits_to_dispatcher_} {
+    Analyze();
+}
+
+CFG::CFG(Environment& env_, ObjectPool<Block>& block_pool_, Location start_address,
+         bool exits_to_dispatcher_, CFGCache& cache, u64 code_hash)
+    : env{env_}, block_pool{block_pool_}, program_start{start_address}, exits_to_dispatcher{
+                                                                            exits_to_dispatcher_} {
+    size_t key{code_hash};
+    Common::HashCombine(key, start_address.Offset());
+    Common::HashCombine(key, static_cast<u32>(exits_to_dispatcher));
+    if (cache.Restore(*this, key)) {
+        return;
+    }
+    Analyze();
+    cache.Insert(*this, key);
+}
+
+void CFG::Analyze() {
     if (exits_to_dispatcher) {
         dispatch_block = block_pool.Create(Block{});
         dispatch_block->begin = {};
@@ -198,7 +217,7 @@ CFG::CFG(Environment& env_, ObjectPool<Block>& block_pool_, Location start_addre
         dispatch_block->branch_true = nullptr;
         dispatch_block->branch_false = nullptr;
     }
-    functions.emplace_back(block_pool, start_address);
+    functions.emplace_back(block_pool, program_start);
     for (FunctionId function_id = 0; function_id < functions.size(); ++function_id) {
         while (!functions[function_id].labels.empty()) {
             Function& function{functions[function_id]};
@@ -271,6 +290,8 @@ bool CFG::InspectVisitedBlocks(FunctionId function_id, const Label& label) {
 
 CFG::AnalysisState CFG::AnalyzeInst(Block* block, FunctionId function_id, Location pc) {
     const Instruction inst{env.ReadInstruction(pc.Offset())};
+    read_lowest = std::min(read_lowest, pc.Offset());
+    read_highest = std::max(read_highest, pc.Offset());
     const Opcode opcode{Decode(inst.raw)};
     switch (opcode) {
     case Opcode::BRA:
@@ -441,7 +462,7 @@ CFG::AnalysisState CFG::AnalyzeBRX(Block* block, Location pc, Instruction inst,
     std::vector<u32> targets;
     targets.reserve(brx_table->num_entries);
     for (u32 i = 0; i < brx_table->num_entries; ++i) {
-        u32 target{env.ReadCbufValue(brx_table->cbuf_index, brx_table->cbuf_offset + i * 4)};
+        u32 target{ReadCbufValue(brx_table->cbuf_index, brx_table->cbuf_offset + i * 4)};
         if (!is_absolute) {
             target += pc.Offset();
         }
@@ -518,6 +539,12 @@ CFG::AnalysisState CFG::AnalyzeEXIT(Block* block, FunctionId function_id, Locati
     return AnalysisState::Branch;
 }
 
+u32 CFG::ReadCbufValue(u32 cbuf_index, u32 cbuf_offset) {
+    const u32 value{env.ReadCbufValue(cbuf_index, cbuf_offset)};
+    cbuf_reads.push_back({cbuf_index, cbuf_offset, value});
+    return value;
+}
+
 Block* CFG::AddLabel(Block* block, Stack stack, Location pc, FunctionId function_id) {
     Function& function{functions[function_id]};
     if (block->begin == pc) {
@@ -639,4 +666,167 @@ std::string CFG::Dot() const {
     return dot;
 }
 
+struct CFGCache::Entry {
+    static constexpr u32 NULL_BLOCK{~0U};
+
+    struct BlockData {
+        Location begin;
+        Location end;
+        EndClass end_class;
+        IR::Condition cond;
+        Stack stack;
+        u32 branch_true;
+        u32 branch_false;
+        FunctionId function_call;
+        u32 return_block;
+        IR::Reg branch_reg;
+        s32 branch_offset;
+        std::vector<std::pair<u32, u32>> indirect_branches;
+    };
+
+    struct FunctionData {
+        Location entrypoint;
+        u32 num_blocks;
+    };
+
+    std::vector<CFG::CbufRead> cbuf_reads;
+    u32 read_lowest;
+    u32 read_highest;
+    std::vector<FunctionData> functions;
+    std::vector<BlockData> blocks;
+};
+
+CFGCache::CFGCache() = default;
+
+CFGCache::~CFGCache() = default;
+
+bool CFGCache::Restore(CFG& cfg, u64 key) {
+    std::vector<std::shared_ptr<const Entry>> variants;
+    {
+        std::scoped_lock lock{mutex};
+        const auto it{entries.find(key)};
+        if (it == entries.end()) {
+            return false;
+        }
+        variants = it->second;
+    }
+    const auto is_valid{[&cfg](const Entry& entry) {
+        // Reading the values again also records them in the environment
+        return std::ranges::all_of(entry.cbuf_reads, [&cfg](const CFG::CbufRead& read) {
+            return cfg.ReadCbufValue(read.index, read.offset) == read.value;
+        });
+    }};
+    const auto variant_it{std::ranges::find_if(
+        variants, [&](const std::shared_ptr<const Entry>& entry) { return is_valid(*entry); })};
+    if (variant_it == variants.end()) {
+        cfg.cbuf_reads.clear();
+        return false;
+    }
+    const Entry& entry{**variant_it};
+    // Environments serialize the range of code read, read its bounds to keep it identical
+    static_cast<void>(cfg.env.ReadInstruction(entry.read_lowest));
+    static_cast<void>(cfg.env.ReadInstruction(entry.read_highest));
+    cfg.read_lowest = entry.read_lowest;
+    cfg.read_highest = entry.read_highest;
+    std::vector<Block*> blocks(entry.blocks.size());
+    for (Block*& block : blocks) {
+        block = cfg.block_pool.Create();
+    }
+    const auto block_at{[&blocks](u32 index) {
+        return index == Entry::NULL_BLOCK ? nullptr : blocks[index];
+    }};
+    for (size_t index = 0; index < blocks.size(); ++index) {
+        const Entry::BlockData& data{entry.blocks[index]};
+        Block& block{*blocks[index]};
+        block.begin = data.begin;
+        block.end = data.end;
+        block.end_class = data.end_class;
+        block.cond = data.cond;
+        block.stack = data.stack;
+        block.branch_true = block_at(data.branch_true);
+        block.branch_false = block_at(data.branch_false);
+        block.function_call = data.function_call;
+        block.return_block = block_at(data.return_block);
+        block.branch_reg = data.branch_reg;
+        block.branch_offset = data.branch_offset;
+        block.indirect_branches.reserve(data.indirect_branches.size());
+        for (const auto& [target, address] : data.indirect_branches) {
+            block.indirect_branches.push_back({
+                .block = blocks[target],
+                .address = address,
+            });
+        }
+    }
+    cfg.functions.clear();
+    size_t block_index{};
+    for (const Entry::FunctionData& data : entry.functions) {
+        Function& function{cfg.functions.emplace_back(data.entrypoint)};
+        for (u32 index = 0; index < data.num_blocks; ++index) {
+            // Blocks are stored in order, insert them at the end without searching
+            function.blocks.insert(function.blocks.end(), *blocks[block_index++]);
+        }
+    }
+    return true;
+}
+
+void CFGCache::Insert(const CFG& cfg, u64 key) {
+    std::unordered_map<const Block*, u32> block_indices;
+    for (const Function& function : cfg.functions) {
+        for (const Block& block : function.blocks) {
+            block_indices.emplace(&block, static_cast<u32>(block_indices.size()));
+        }
+    }
+    bool is_complete{true};
+    const auto index_of{[&](const Block* block) {
+        if (!block) {
+            return Entry::NULL_BLOCK;
+        }
+        const auto it{block_indices.find(block)};
+        if (it == block_indices.end()) {
+            // Graphs pointing to blocks outside of their functions are not cached
+            is_complete = false;
+            return Entry::NULL_BLOCK;
+        }
+        return it->second;
+    }};
+    auto entry{std::make_shared<Entry>()};
+    entry->cbuf_reads = cfg.cbuf_reads;
+    entry->read_lowest = cfg.read_lowest;
+    entry->read_highest = cfg.read_highest;
+    entry->blocks.reserve(block_indices.size());
+    for (const Function& function : cfg.functions) {
+        entry->functions.push_back({
+            .entrypoint = function.entrypoint,
+            .num_blocks = static_cast<u32>(function.blocks.size()),
+        });
+        for (const Block& block : function.blocks) {
+            Entry::BlockData& data{entry->blocks.emplace_back(Entry::BlockData{
+                .begin = block.begin,
+                .end = block.end,
+                .end_class = block.end_class,
+                .cond = block.cond,
+                .stack = block.stack,
+                .branch_true = index_of(block.branch_true),
+                .branch_false = index_of(block.branch_false),
+                .function_call = block.function_call,
+                .return_block = index_of(block.return_block),
+                .branch_reg = block.branch_reg,
+                .branch_offset = block.branch_offset,
+                .indirect_branches{},
+            })};
+            for (const IndirectBranch& branch : block.indirect_branches) {
+                data.indirect_branches.emplace_back(index_of(branch.block), branch.address);
+            }
+        }
+    }
+    if (!is_complete || cfg.read_lowest > cfg.read_highest) {
+        return;
+    }
+    std::scoped_lock lock{mutex};
+    auto& variants{entries[key]};
+    if (variants.size() < MAX_VARIANTS) {
+        variants.push_back(std::move(entry));
+    }
+}
+
 } // namespace Shader::Maxwell::Flow
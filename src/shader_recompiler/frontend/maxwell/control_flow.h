@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/container/small_vector.hpp>
@@ -97,12 +101,15 @@ struct Label {
 
 struct Function {
     explicit Function(ObjectPool<Block>& block_pool, Location start_address);
+    explicit Function(Location start_address) : entrypoint{start_address} {}
 
     Location entrypoint;
     boost::container::small_vector<Label, 16> labels;
     boost::intrusive::set<Block> blocks;
 };
 
+class CFGCache;
+
 class CFG {
     enum class AnalysisState {
         Branch,
@@ -113,6 +120,11 @@ public:
     explicit CFG(Environment& env, ObjectPool<Block>& block_pool, Location start_address,
                  bool exits_to_dispatcher = false);
 
+    /// Builds the graph from a previous analysis of the same code when the environment reads it
+    /// depended on return the same values, otherwise analyzes it and stores the result in the cache
+    explicit CFG(Environment& env, ObjectPool<Block>& block_pool, Location start_address,
+                 bool exits_to_dispatcher, CFGCache& cache, u64 code_hash);
+
     CFG& operator=(const CFG&) = delete;
     CFG(const CFG&) = delete;
 
@@ -133,6 +145,19 @@ public:
     }
 
 private:
+    friend class CFGCache;
+
+    struct CbufRead {
+        u32 index;
+        u32 offset;
+        u32 value;
+    };
+
+    void Analyze();
+
+    /// Reads a constant buffer value, recording it as a dependency of the analysis
+    [[nodiscard]] u32 ReadCbufValue(u32 cbuf_index, u32 cbuf_offset);
+
     void AnalyzeLabel(FunctionId function_id, Label& label);
 
     /// Inspect already visited blocks.
@@ -163,6 +188,37 @@ private:
     Location program_start;
     bool exits_to_dispatcher{};
     Block* dispatch_block{};
+    std::vector<CbufRead> cbuf_reads;
+    u32 read_lowest{std::numeric_limits<u32>::max()};
+    u32 read_highest{};
+};
+
+/// Memoizes control flow graphs by code hash, shared between the threads building shaders.
+/// Graphs are stored independently of the block pools, a hit copies them into the caller's pool.
+class CFGCache {
+public:
+    CFGCache();
+    ~CFGCache();
+
+    CFGCache(const CFGCache&) = delete;
+    CFGCache& operator=(const CFGCache&) = delete;
+
+private:
+    friend class CFG;
+
+    struct Entry;
+
+    /// Maximum number of graphs stored for the same code, one per distinct set of cbuf reads
+    static constexpr size_t MAX_VARIANTS = 8;
+
+    /// Restores a cached graph into the CFG, returns false when there's no valid one
+    bool Restore(CFG& cfg, u64 key);
+
+    /// Stores the graph of an analyzed CFG
+    void Insert(const CFG& cfg, u64 key);
+
+    std::mutex mutex;
+    std::unordered_map<u64, std::vector<std::shared_ptr<const Entry>>> entries;
 };
 
 } // namespace Shader::Maxwell::Flow
@@ -142,6 +142,7 @@ struct Statement : ListBaseHook {
         IR::Reg branch_reg;
     };
     Statement* up{};
+    u64 order{}; ///< Key ordering the statement among its siblings
     StatementType type;
 };
 #ifdef _MSC_VER
@@ -229,6 +230,31 @@ void SanitizeNoBreaks(const Tree& tree) {
     }
 }
 
+/// Distance between the order keys of adjacent siblings after renumbering them
+constexpr u64 ORDER_SPACING{u64{1} << 20};
+
+void RenumberSiblings(Tree& tree) {
+    u64 order{ORDER_SPACING};
+    for (Statement& stmt : tree) {
+        stmt.order = order;
+        order += ORDER_SPACING;
+    }
+}
+
+/// Inserts a statement in a tree, giving it an order key between its new siblings
+Node Insert(Tree& tree, Node insert_point, Statement& stmt) {
+    const Node node{tree.insert(insert_point, stmt)};
+    const u64 low{node != tree.begin() ? std::prev(node)->order : 0};
+    const u64 high{insert_point != tree.end() ? insert_point->order : low + 2 * ORDER_SPACING};
+    if (high <= low || high - low < 2) {
+        // No room left between the siblings
+        RenumberSiblings(tree);
+    } else {
+        node->order = low + (high - low) / 2;
+    }
+    return node;
+}
+
 size_t Level(Node stmt) {
     size_t level{0};
     Statement* node{stmt->up};
@@ -239,9 +265,7 @@ size_t Level(Node stmt) {
     return level;
 }
 
-bool IsDirectlyRelated(Node goto_stmt, Node label_stmt) {
-    const size_t goto_level{Level(goto_stmt)};
-    const size_t label_level{Level(label_stmt)};
+bool IsDirectlyRelated(Node goto_stmt, Node label_stmt, size_t goto_level, size_t label_level) {
     size_t min_level;
     size_t max_level;
     Node min;
@@ -264,8 +288,10 @@ bool IsDirectlyRelated(Node goto_stmt, Node label_stmt) {
     return min->up == max->up;
 }
 
-bool IsIndirectlyRelated(Node goto_stmt, Node label_stmt) {
-    return goto_stmt->up != label_stmt->up && !IsDirectlyRelated(goto_stmt, label_stmt);
+bool IsIndirectlyRelated(Node goto_stmt, Node label_stmt, size_t goto_level,
+                         size_t label_level) {
+    return goto_stmt->up != label_stmt->up &&
+           !IsDirectlyRelated(goto_stmt, label_stmt, goto_level, label_level);
 }
 
 [[maybe_unused]] bool AreSiblings(Node goto_stmt, Node label_stmt) noexcept {
@@ -295,13 +321,7 @@ Node SiblingFromNephew(Node uncle, Node nephew) noexcept {
 }
 
 bool AreOrdered(Node left_sibling, Node right_sibling) noexcept {
-    const Node end{right_sibling->up->children.end()};
-    for (auto it = right_sibling; it != end; ++it) {
-        if (it == left_sibling) {
-            return false;
-        }
-    }
-    return true;
+    return left_sibling->order < right_sibling->order;
 }
 
 bool NeedsLift(Node goto_stmt, Node label_stmt) noexcept {
@@ -325,19 +345,23 @@ public:
 
 private:
     void RemoveGoto(Node goto_stmt) {
-        // Force goto_stmt and label_stmt to be directly related
+        // Nesting depths are computed once and tracked as the goto moves, lifting nests both
+        // statements one level deeper so their difference stays valid
         const Node label_stmt{goto_stmt->label};
-        if (IsIndirectlyRelated(goto_stmt, label_stmt)) {
+        const size_t label_level{Level(label_stmt)};
+        size_t goto_level{Level(goto_stmt)};
+
+        // Force goto_stmt and label_stmt to be directly related
+        if (IsIndirectlyRelated(goto_stmt, label_stmt, goto_level, label_level)) {
             // Move goto_stmt out using outward-movement transformation until it becomes
             // directly related to label_stmt
-            while (!IsDirectlyRelated(goto_stmt, label_stmt)) {
+            while (!IsDirectlyRelated(goto_stmt, label_stmt, goto_level, label_level)) {
                 goto_stmt = MoveOutward(goto_stmt);
+                --goto_level;
             }
         }
         // Force goto_stmt and label_stmt to be siblings
-        if (IsDirectlyRelated(goto_stmt, label_stmt)) {
-            const size_t label_level{Level(label_stmt)};
-            size_t goto_level{Level(goto_stmt)};
+        if (IsDirectlyRelated(goto_stmt, label_stmt, goto_level, label_level)) {
             if (goto_level > label_level) {
                 // Move goto_stmt out of its level using outward-movement transformations
                 while (goto_level > label_level) {
@@ -379,6 +403,7 @@ private:
         std::vector<Node> gotos;
         Flow::Function& first_function{cfg.Functions().front()};
         BuildTree(cfg, first_function, label_id, gotos, root_stmt.children.end(), std::nullopt);
+        RenumberSiblings(root_stmt.children);
         return gotos;
     }
 
@@ -479,7 +504,7 @@ private:
         Statement* const cond{pool.Create(Not{}, goto_stmt->cond, &root_stmt)};
         Statement* const if_stmt{pool.Create(If{}, cond, std::move(if_body), goto_stmt->up)};
         UpdateTreeUp(if_stmt);
-        body.insert(goto_stmt, *if_stmt);
+        Insert(body, goto_stmt, *if_stmt);
         body.erase(goto_stmt);
     }
 
@@ -490,7 +515,7 @@ private:
         Statement* const cond{goto_stmt->cond};
         Statement* const loop{pool.Create(Loop{}, cond, std::move(loop_body), goto_stmt->up)};
         UpdateTreeUp(loop);
-        body.insert(goto_stmt, *loop);
+        Insert(body, goto_stmt, *loop);
         body.erase(goto_stmt);
     }
 
@@ -514,7 +539,7 @@ private:
 
         Statement* const goto_cond{goto_stmt->cond};
         Statement* const set_var{pool.Create(SetVariable{}, label_id, goto_cond, parent)};
-        body.insert(goto_stmt, *set_var);
+        Insert(body, goto_stmt, *set_var);
 
         Tree if_body;
         if_body.splice(if_body.begin(), body, std::next(goto_stmt), label_nested_stmt);
@@ -523,7 +548,7 @@ private:
         if (!if_body.empty()) {
             Statement* const if_stmt{pool.Create(If{}, neg_var, std::move(if_body), parent)};
             UpdateTreeUp(if_stmt);
-            body.insert(goto_stmt, *if_stmt);
+            Insert(body, goto_stmt, *if_stmt);
         }
         body.erase(goto_stmt);
 
@@ -540,7 +565,7 @@ private:
         }
         Tree& nested_tree{label_nested_stmt->children};
         Statement* const new_goto{pool.Create(Goto{}, variable, label, &*label_nested_stmt)};
-        return nested_tree.insert(nested_tree.begin(), *new_goto);
+        return Insert(nested_tree, nested_tree.begin(), *new_goto);
     }
 
     [[nodiscard]] Node Lift(Node goto_stmt) {
@@ -556,14 +581,14 @@ private:
         Statement* const variable{pool.Create(Variable{}, label_id, &root_stmt)};
         Statement* const loop_stmt{pool.Create(Loop{}, variable, std::move(loop_body), parent)};
         UpdateTreeUp(loop_stmt);
-        body.insert(goto_stmt, *loop_stmt);
+        Insert(body, goto_stmt, *loop_stmt);
 
+        Tree& loop_tree{loop_stmt->children};
         Statement* const new_goto{pool.Create(Goto{}, variable, label, loop_stmt)};
-        loop_stmt->children.push_front(*new_goto);
-        const Node new_goto_node{loop_stmt->children.begin()};
+        const Node new_goto_node{Insert(loop_tree, loop_tree.begin(), *new_goto)};
 
         Statement* const set_var{pool.Create(SetVariable{}, label_id, goto_stmt->cond, loop_stmt)};
-        loop_stmt->children.push_back(*set_var);
+        Insert(loop_tree, loop_tree.end(), *set_var);
 
         body.erase(goto_stmt);
         return new_goto_node;
@@ -575,7 +600,7 @@ private:
         const u32 label_id{goto_stmt->label->id};
         Statement* const goto_cond{goto_stmt->cond};
         Statement* const set_goto_var{pool.Create(SetVariable{}, label_id, goto_cond, &*parent)};
-        body.insert(goto_stmt, *set_goto_var);
+        Insert(body, goto_stmt, *set_goto_var);
 
         Tree if_body;
         if_body.splice(if_body.begin(), body, std::next(goto_stmt), body.end());
@@ -584,14 +609,14 @@ private:
         Statement* const neg_cond{pool.Create(Not{}, cond, &root_stmt)};
         Statement* const if_stmt{pool.Create(If{}, neg_cond, std::move(if_body), &*parent)};
         UpdateTreeUp(if_stmt);
-        body.insert(goto_stmt, *if_stmt);
+        Insert(body, goto_stmt, *if_stmt);
 
         body.erase(goto_stmt);
 
         Statement* const new_cond{pool.Create(Variable{}, label_id, &root_stmt)};
         Statement* const new_goto{pool.Create(Goto{}, new_cond, goto_stmt->label, parent->up)};
         Tree& parent_tree{parent->up->children};
-        return parent_tree.insert(std::next(parent), *new_goto);
+        return Insert(parent_tree, std::next(parent), *new_goto);
     }
 
     Node MoveOutwardLoop(Node goto_stmt) {
@@ -602,15 +627,15 @@ private:
         Statement* const set_goto_var{pool.Create(SetVariable{}, label_id, goto_cond, parent)};
         Statement* const cond{pool.Create(Variable{}, label_id, &root_stmt)};
         Statement* const break_stmt{pool.Create(Break{}, cond, parent)};
-        body.insert(goto_stmt, *set_goto_var);
-        body.insert(goto_stmt, *break_stmt);
+        Insert(body, goto_stmt, *set_goto_var);
+        Insert(body, goto_stmt, *break_stmt);
         body.erase(goto_stmt);
 
         const Node loop{Tree::s_iterator_to(*goto_stmt->up)};
         Statement* const new_goto_cond{pool.Create(Variable{}, label_id, &root_stmt)};
         Statement* const new_goto{pool.Create(Goto{}, new_goto_cond, goto_stmt->label, loop->up)};
         Tree& parent_tree{loop->up->children};
-        return parent_tree.insert(std::next(loop), *new_goto);
+        return Insert(parent_tree, std::next(loop), *new_goto);
     }
 
     ObjectPool<Statement>& pool;
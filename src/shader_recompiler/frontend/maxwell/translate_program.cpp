@@ -16,6 +16,7 @@
 #include "shader_recompiler/frontend/maxwell/translate_program.h"
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/pass_timings.h"
 
 namespace Shader::Maxwell {
 namespace {
@@ -237,10 +238,14 @@ void LowerGeometryPassthrough(const IR::Program& program, const HostTranslateInf
 
 } // Anonymous namespace
 
-IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
-                             Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info) {
+IR::Program TranslateProgramBase(ObjectPool<IR::Inst>& inst_pool,
+                                 ObjectPool<IR::Block>& block_pool, Environment& env,
+                                 Flow::CFG& cfg, const HostTranslateInfo& host_info,
+                                 PassTimings* timings) {
     IR::Program program;
-    program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
+    RunPass(timings, "BuildASL", [&] {
+        program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
+    });
     program.blocks = GenerateBlocks(program.syntax_list);
     program.post_order_blocks = PostOrder(program.syntax_list.front());
     program.stage = env.ShaderStage();
@@ -281,39 +286,61 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
 
     // Replace instructions before the SSA rewrite
     if (!host_info.support_float64) {
-        Optimization::LowerFp64ToFp32(program);
+        RunPass(timings, "LowerFp64ToFp32", [&] { Optimization::LowerFp64ToFp32(program); });
     }
     if (!host_info.support_float16) {
-        Optimization::LowerFp16ToFp32(program);
+        RunPass(timings, "LowerFp16ToFp32", [&] { Optimization::LowerFp16ToFp32(program); });
     }
     if (!host_info.support_int64) {
-        Optimization::LowerInt64ToInt32(program);
+        RunPass(timings, "LowerInt64ToInt32", [&] { Optimization::LowerInt64ToInt32(program); });
     }
     if (!host_info.support_conditional_barrier) {
-        Optimization::ConditionalBarrierPass(program);
+        RunPass(timings, "ConditionalBarrierPass",
+                [&] { Optimization::ConditionalBarrierPass(program); });
+    }
+    RunPass(timings, "SsaRewritePass", [&] { Optimization::SsaRewritePass(program); });
+
+    RunPass(timings, "ConstantPropagationPass",
+            [&] { Optimization::ConstantPropagationPass(env, program); });
+    if (host_info.enable_global_optimizations) {
+        RunPass(timings, "SparseConditionalConstantPropagationPass",
+                [&] { Optimization::SparseConditionalConstantPropagationPass(program); });
+        RunPass(timings, "GlobalValueNumberingPass",
+                [&] { Optimization::GlobalValueNumberingPass(program); });
     }
-    Optimization::SsaRewritePass(program);
-
-    Optimization::ConstantPropagationPass(env, program);
 
-    Optimization::PositionPass(env, program);
+    RunPass(timings, "PositionPass", [&] { Optimization::PositionPass(env, program); });
 
-    Optimization::GlobalMemoryToStorageBufferPass(program, host_info);
-    Optimization::TexturePass(env, program, host_info);
+    RunPass(timings, "GlobalMemoryToStorageBufferPass",
+            [&] { Optimization::GlobalMemoryToStorageBufferPass(program, host_info); });
+    RunPass(timings, "TexturePass", [&] { Optimization::TexturePass(env, program, host_info); });
+    return program;
+}
 
+void FinalizeProgram(Environment& env, IR::Program& program, const HostTranslateInfo& host_info,
+                     PassTimings* timings) {
     if (Settings::values.resolution_info.active) {
-        Optimization::RescalingPass(program);
+        RunPass(timings, "RescalingPass", [&] { Optimization::RescalingPass(program); });
     }
-    Optimization::DeadCodeEliminationPass(program);
+    RunPass(timings, "DeadCodeEliminationPass",
+            [&] { Optimization::DeadCodeEliminationPass(program); });
     if (Settings::values.renderer_debug) {
-        Optimization::VerificationPass(program);
+        RunPass(timings, "VerificationPass", [&] { Optimization::VerificationPass(program); });
     }
-    Optimization::CollectShaderInfoPass(env, program);
-    Optimization::LayerPass(program, host_info);
-    Optimization::VendorWorkaroundPass(program);
+    RunPass(timings, "CollectShaderInfoPass",
+            [&] { Optimization::CollectShaderInfoPass(env, program); });
+    RunPass(timings, "LayerPass", [&] { Optimization::LayerPass(program, host_info); });
+    RunPass(timings, "VendorWorkaroundPass", [&] { Optimization::VendorWorkaroundPass(program); });
 
     CollectInterpolationInfo(env, program);
     AddNVNStorageBuffers(program);
+}
+
+IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
+                             Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info,
+                             PassTimings* timings) {
+    IR::Program program{TranslateProgramBase(inst_pool, block_pool, env, cfg, host_info, timings)};
+    FinalizeProgram(env, program, host_info, timings);
     return program;
 }
 
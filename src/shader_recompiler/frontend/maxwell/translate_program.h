@@ -12,13 +12,27 @@
 
 namespace Shader {
 struct HostTranslateInfo;
-}
+class PassTimings;
+} // namespace Shader
 
 namespace Shader::Maxwell {
 
+// Translation is split in two halves. The result of the first one only depends on the guest
+// shader and the host translation info, so it can be serialized and finalized in a later boot
+// when profile dependent settings like resolution scaling change.
+[[nodiscard]] IR::Program TranslateProgramBase(ObjectPool<IR::Inst>& inst_pool,
+                                               ObjectPool<IR::Block>& block_pool,
+                                               Environment& env, Flow::CFG& cfg,
+                                               const HostTranslateInfo& host_info,
+                                               PassTimings* timings = nullptr);
+
+void FinalizeProgram(Environment& env, IR::Program& program, const HostTranslateInfo& host_info,
+                     PassTimings* timings = nullptr);
+
 [[nodiscard]] IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool,
                                            ObjectPool<IR::Block>& block_pool, Environment& env,
-                                           Flow::CFG& cfg, const HostTranslateInfo& host_info);
+                                           Flow::CFG& cfg, const HostTranslateInfo& host_info,
+                                           PassTimings* timings = nullptr);
 
 [[nodiscard]] IR::Program MergeDualVertexPrograms(IR::Program& vertex_a, IR::Program& vertex_b,
                                                   Environment& env_vertex_b);
@@ -21,6 +21,7 @@ struct HostTranslateInfo {
                                                 ///< passthrough shaders
     bool support_conditional_barrier{}; ///< True when the device supports barriers in conditional
                                         ///< control flow
+    bool enable_global_optimizations{}; ///< True when SCCP and value numbering passes are run
 };
 
 } // namespace Shader
@@ -0,0 +1,490 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Dominator based value numbering, eliminating instructions that compute the same value as an
+// instruction in a dominating block. Dominators are computed as described in:
+// Cooper, K. D., Harvey, T. J. and Kennedy, K. 2001. A Simple, Fast Dominance Algorithm.
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "common/bit_cast.h"
+#include "common/common_types.h"
+#include "common/container_hash.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+constexpr size_t NO_DOMINATOR{std::numeric_limits<size_t>::max()};
+
+struct Expression {
+    [[nodiscard]] bool operator==(const Expression&) const = default;
+
+    IR::Opcode opcode{};
+    u32 flags{};
+    boost::container::small_vector<IR::Value, 4> args;
+};
+
+u64 ImmediateBits(const IR::Value& value) {
+    switch (value.Type()) {
+    case IR::Type::U1:
+        return value.U1() ? 1 : 0;
+    case IR::Type::U8:
+        return value.U8();
+    case IR::Type::U16:
+        return value.U16();
+    case IR::Type::U32:
+        return value.U32();
+    case IR::Type::F32:
+        return Common::BitCast<u32>(value.F32());
+    case IR::Type::U64:
+        return value.U64();
+    case IR::Type::F64:
+        return Common::BitCast<u64>(value.F64());
+    case IR::Type::Reg:
+        return static_cast<u64>(value.Reg());
+    case IR::Type::Pred:
+        return static_cast<u64>(value.Pred());
+    case IR::Type::Attribute:
+        return static_cast<u64>(value.Attribute());
+    case IR::Type::Patch:
+        return static_cast<u64>(value.Patch());
+    default:
+        return 0;
+    }
+}
+
+struct ExpressionHash {
+    size_t operator()(const Expression& expression) const {
+        size_t hash{static_cast<size_t>(expression.opcode)};
+        Common::HashCombine(hash, expression.flags);
+        for (const IR::Value& arg : expression.args) {
+            if (arg.IsImmediate()) {
+                Common::HashCombine(hash, ImmediateBits(arg));
+            } else {
+                Common::HashCombine(hash, reinterpret_cast<uintptr_t>(arg.Inst()));
+            }
+        }
+        return hash;
+    }
+};
+
+bool IsCommutative(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::IAdd64:
+    case IR::Opcode::IMul32:
+    case IR::Opcode::BitwiseAnd32:
+    case IR::Opcode::BitwiseOr32:
+    case IR::Opcode::BitwiseXor32:
+    case IR::Opcode::SMin32:
+    case IR::Opcode::UMin32:
+    case IR::Opcode::SMax32:
+    case IR::Opcode::UMax32:
+    case IR::Opcode::IEqual:
+    case IR::Opcode::INotEqual:
+    case IR::Opcode::LogicalOr:
+    case IR::Opcode::LogicalAnd:
+    case IR::Opcode::LogicalXor:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Returns true when the instruction only depends on its arguments and can be numbered
+bool IsNumberable(const IR::Inst& inst) {
+    if (inst.MayHaveSideEffects() || inst.IsPseudoInstruction() ||
+        inst.HasAssociatedPseudoOperation()) {
+        return false;
+    }
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::GetCbufU8:
+    case IR::Opcode::GetCbufS8:
+    case IR::Opcode::GetCbufU16:
+    case IR::Opcode::GetCbufS16:
+    case IR::Opcode::GetCbufU32:
+    case IR::Opcode::GetCbufF32:
+    case IR::Opcode::GetCbufU32x2:
+        // Constant buffers can't be written from shaders
+        return true;
+    // Composite vectors, selects and bitwise conversions
+    case IR::Opcode::CompositeConstructU32x2:
+    case IR::Opcode::CompositeConstructU32x3:
+    case IR::Opcode::CompositeConstructU32x4:
+    case IR::Opcode::CompositeExtractU32x2:
+    case IR::Opcode::CompositeExtractU32x3:
+    case IR::Opcode::CompositeExtractU32x4:
+    case IR::Opcode::CompositeInsertU32x2:
+    case IR::Opcode::CompositeInsertU32x3:
+    case IR::Opcode::CompositeInsertU32x4:
+    case IR::Opcode::CompositeConstructF16x2:
+    case IR::Opcode::CompositeConstructF16x3:
+    case IR::Opcode::CompositeConstructF16x4:
+    case IR::Opcode::CompositeExtractF16x2:
+    case IR::Opcode::CompositeExtractF16x3:
+    case IR::Opcode::CompositeExtractF16x4:
+    case IR::Opcode::CompositeInsertF16x2:
+    case IR::Opcode::CompositeInsertF16x3:
+    case IR::Opcode::CompositeInsertF16x4:
+    case IR::Opcode::CompositeConstructF32x2:
+    case IR::Opcode::CompositeConstructF32x3:
+    case IR::Opcode::CompositeConstructF32x4:
+    case IR::Opcode::CompositeExtractF32x2:
+    case IR::Opcode::CompositeExtractF32x3:
+    case IR::Opcode::CompositeExtractF32x4:
+    case IR::Opcode::CompositeInsertF32x2:
+    case IR::Opcode::CompositeInsertF32x3:
+    case IR::Opcode::CompositeInsertF32x4:
+    case IR::Opcode::CompositeConstructF64x2:
+    case IR::Opcode::CompositeConstructF64x3:
+    case IR::Opcode::CompositeConstructF64x4:
+    case IR::Opcode::CompositeExtractF64x2:
+    case IR::Opcode::CompositeExtractF64x3:
+    case IR::Opcode::CompositeExtractF64x4:
+    case IR::Opcode::CompositeInsertF64x2:
+    case IR::Opcode::CompositeInsertF64x3:
+    case IR::Opcode::CompositeInsertF64x4:
+    case IR::Opcode::SelectU1:
+    case IR::Opcode::SelectU8:
+    case IR::Opcode::SelectU16:
+    case IR::Opcode::SelectU32:
+    case IR::Opcode::SelectU64:
+    case IR::Opcode::SelectF16:
+    case IR::Opcode::SelectF32:
+    case IR::Opcode::SelectF64:
+    case IR::Opcode::BitCastU16F16:
+    case IR::Opcode::BitCastU32F32:
+    case IR::Opcode::BitCastU64F64:
+    case IR::Opcode::BitCastF16U16:
+    case IR::Opcode::BitCastF32U32:
+    case IR::Opcode::BitCastF64U64:
+    case IR::Opcode::PackUint2x32:
+    case IR::Opcode::UnpackUint2x32:
+    case IR::Opcode::PackFloat2x16:
+    case IR::Opcode::UnpackFloat2x16:
+    case IR::Opcode::PackHalf2x16:
+    case IR::Opcode::UnpackHalf2x16:
+    case IR::Opcode::PackDouble2x32:
+    case IR::Opcode::UnpackDouble2x32:
+    // Floating-point operations
+    case IR::Opcode::FPAbs16:
+    case IR::Opcode::FPAbs32:
+    case IR::Opcode::FPAbs64:
+    case IR::Opcode::FPAdd16:
+    case IR::Opcode::FPAdd32:
+    case IR::Opcode::FPAdd64:
+    case IR::Opcode::FPFma16:
+    case IR::Opcode::FPFma32:
+    case IR::Opcode::FPFma64:
+    case IR::Opcode::FPMax32:
+    case IR::Opcode::FPMax64:
+    case IR::Opcode::FPMin32:
+    case IR::Opcode::FPMin64:
+    case IR::Opcode::FPMul16:
+    case IR::Opcode::FPMul32:
+    case IR::Opcode::FPMul64:
+    case IR::Opcode::FPNeg16:
+    case IR::Opcode::FPNeg32:
+    case IR::Opcode::FPNeg64:
+    case IR::Opcode::FPRecip32:
+    case IR::Opcode::FPRecip64:
+    case IR::Opcode::FPRecipSqrt32:
+    case IR::Opcode::FPRecipSqrt64:
+    case IR::Opcode::FPSqrt:
+    case IR::Opcode::FPSin:
+    case IR::Opcode::FPExp2:
+    case IR::Opcode::FPCos:
+    case IR::Opcode::FPLog2:
+    case IR::Opcode::FPSaturate16:
+    case IR::Opcode::FPSaturate32:
+    case IR::Opcode::FPSaturate64:
+    case IR::Opcode::FPClamp16:
+    case IR::Opcode::FPClamp32:
+    case IR::Opcode::FPClamp64:
+    case IR::Opcode::FPRoundEven16:
+    case IR::Opcode::FPRoundEven32:
+    case IR::Opcode::FPRoundEven64:
+    case IR::Opcode::FPFloor16:
+    case IR::Opcode::FPFloor32:
+    case IR::Opcode::FPFloor64:
+    case IR::Opcode::FPCeil16:
+    case IR::Opcode::FPCeil32:
+    case IR::Opcode::FPCeil64:
+    case IR::Opcode::FPTrunc16:
+    case IR::Opcode::FPTrunc32:
+    case IR::Opcode::FPTrunc64:
+    case IR::Opcode::FPOrdEqual16:
+    case IR::Opcode::FPOrdEqual32:
+    case IR::Opcode::FPOrdEqual64:
+    case IR::Opcode::FPUnordEqual16:
+    case IR::Opcode::FPUnordEqual32:
+    case IR::Opcode::FPUnordEqual64:
+    case IR::Opcode::FPOrdNotEqual16:
+    case IR::Opcode::FPOrdNotEqual32:
+    case IR::Opcode::FPOrdNotEqual64:
+    case IR::Opcode::FPUnordNotEqual16:
+    case IR::Opcode::FPUnordNotEqual32:
+    case IR::Opcode::FPUnordNotEqual64:
+    case IR::Opcode::FPOrdLessThan16:
+    case IR::Opcode::FPOrdLessThan32:
+    case IR::Opcode::FPOrdLessThan64:
+    case IR::Opcode::FPUnordLessThan16:
+    case IR::Opcode::FPUnordLessThan32:
+    case IR::Opcode::FPUnordLessThan64:
+    case IR::Opcode::FPOrdGreaterThan16:
+    case IR::Opcode::FPOrdGreaterThan32:
+    case IR::Opcode::FPOrdGreaterThan64:
+    case IR::Opcode::FPUnordGreaterThan16:
+    case IR::Opcode::FPUnordGreaterThan32:
+    case IR::Opcode::FPUnordGreaterThan64:
+    case IR::Opcode::FPOrdLessThanEqual16:
+    case IR::Opcode::FPOrdLessThanEqual32:
+    case IR::Opcode::FPOrdLessThanEqual64:
+    case IR::Opcode::FPUnordLessThanEqual16:
+    case IR::Opcode::FPUnordLessThanEqual32:
+    case IR::Opcode::FPUnordLessThanEqual64:
+    case IR::Opcode::FPOrdGreaterThanEqual16:
+    case IR::Opcode::FPOrdGreaterThanEqual32:
+    case IR::Opcode::FPOrdGreaterThanEqual64:
+    case IR::Opcode::FPUnordGreaterThanEqual16:
+    case IR::Opcode::FPUnordGreaterThanEqual32:
+    case IR::Opcode::FPUnordGreaterThanEqual64:
+    case IR::Opcode::FPIsNan16:
+    case IR::Opcode::FPIsNan32:
+    case IR::Opcode::FPIsNan64:
+    // Integer operations
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::IAdd64:
+    case IR::Opcode::ISub32:
+    case IR::Opcode::ISub64:
+    case IR::Opcode::IMul32:
+    case IR::Opcode::SDiv32:
+    case IR::Opcode::UDiv32:
+    case IR::Opcode::INeg32:
+    case IR::Opcode::INeg64:
+    case IR::Opcode::IAbs32:
+    case IR::Opcode::ShiftLeftLogical32:
+    case IR::Opcode::ShiftLeftLogical64:
+    case IR::Opcode::ShiftRightLogical32:
+    case IR::Opcode::ShiftRightLogical64:
+    case IR::Opcode::ShiftRightArithmetic32:
+    case IR::Opcode::ShiftRightArithmetic64:
+    case IR::Opcode::BitwiseAnd32:
+    case IR::Opcode::BitwiseOr32:
+    case IR::Opcode::BitwiseXor32:
+    case IR::Opcode::BitFieldInsert:
+    case IR::Opcode::BitFieldSExtract:
+    case IR::Opcode::BitFieldUExtract:
+    case IR::Opcode::BitReverse32:
+    case IR::Opcode::BitCount32:
+    case IR::Opcode::BitwiseNot32:
+    case IR::Opcode::FindSMsb32:
+    case IR::Opcode::FindUMsb32:
+    case IR::Opcode::SMin32:
+    case IR::Opcode::UMin32:
+    case IR::Opcode::SMax32:
+    case IR::Opcode::UMax32:
+    case IR::Opcode::SClamp32:
+    case IR::Opcode::UClamp32:
+    case IR::Opcode::SLessThan:
+    case IR::Opcode::ULessThan:
+    case IR::Opcode::IEqual:
+    case IR::Opcode::SLessThanEqual:
+    case IR::Opcode::ULessThanEqual:
+    case IR::Opcode::SGreaterThan:
+    case IR::Opcode::UGreaterThan:
+    case IR::Opcode::INotEqual:
+    case IR::Opcode::SGreaterThanEqual:
+    case IR::Opcode::UGreaterThanEqual:
+    // Logical operations and conversions
+    case IR::Opcode::LogicalOr:
+    case IR::Opcode::LogicalAnd:
+    case IR::Opcode::LogicalXor:
+    case IR::Opcode::LogicalNot:
+    case IR::Opcode::ConvertS16F16:
+    case IR::Opcode::ConvertS16F32:
+    case IR::Opcode::ConvertS16F64:
+    case IR::Opcode::ConvertS32F16:
+    case IR::Opcode::ConvertS32F32:
+    case IR::Opcode::ConvertS32F64:
+    case IR::Opcode::ConvertS64F16:
+    case IR::Opcode::ConvertS64F32:
+    case IR::Opcode::ConvertS64F64:
+    case IR::Opcode::ConvertU16F16:
+    case IR::Opcode::ConvertU16F32:
+    case IR::Opcode::ConvertU16F64:
+    case IR::Opcode::ConvertU32F16:
+    case IR::Opcode::ConvertU32F32:
+    case IR::Opcode::ConvertU32F64:
+    case IR::Opcode::ConvertU64F16:
+    case IR::Opcode::ConvertU64F32:
+    case IR::Opcode::ConvertU64F64:
+    case IR::Opcode::ConvertU64U32:
+    case IR::Opcode::ConvertU32U64:
+    case IR::Opcode::ConvertF16F32:
+    case IR::Opcode::ConvertF32F16:
+    case IR::Opcode::ConvertF32F64:
+    case IR::Opcode::ConvertF64F32:
+    case IR::Opcode::ConvertF16S8:
+    case IR::Opcode::ConvertF16S16:
+    case IR::Opcode::ConvertF16S32:
+    case IR::Opcode::ConvertF16S64:
+    case IR::Opcode::ConvertF16U8:
+    case IR::Opcode::ConvertF16U16:
+    case IR::Opcode::ConvertF16U32:
+    case IR::Opcode::ConvertF16U64:
+    case IR::Opcode::ConvertF32S8:
+    case IR::Opcode::ConvertF32S16:
+    case IR::Opcode::ConvertF32S32:
+    case IR::Opcode::ConvertF32S64:
+    case IR::Opcode::ConvertF32U8:
+    case IR::Opcode::ConvertF32U16:
+    case IR::Opcode::ConvertF32U32:
+    case IR::Opcode::ConvertF32U64:
+    case IR::Opcode::ConvertF64S8:
+    case IR::Opcode::ConvertF64S16:
+    case IR::Opcode::ConvertF64S32:
+    case IR::Opcode::ConvertF64S64:
+    case IR::Opcode::ConvertF64U8:
+    case IR::Opcode::ConvertF64U16:
+    case IR::Opcode::ConvertF64U32:
+    case IR::Opcode::ConvertF64U64:
+        return true;
+    default:
+        // Memory reads, atomics, images, warp operations and new opcodes are not numbered
+        return false;
+    }
+}
+
+Expression MakeExpression(const IR::Inst& inst) {
+    Expression expression{
+        .opcode = inst.GetOpcode(),
+        .flags = inst.Flags<u32>(),
+        .args{},
+    };
+    const size_t num_args{inst.NumArgs()};
+    for (size_t arg_index = 0; arg_index < num_args; ++arg_index) {
+        expression.args.push_back(inst.Arg(arg_index).Resolve());
+    }
+    if (IsCommutative(expression.opcode)) {
+        IR::Value& lhs{expression.args[0]};
+        IR::Value& rhs{expression.args[1]};
+        // Immediates go last, instructions are sorted by address
+        const bool swap{lhs.IsImmediate() ? !rhs.IsImmediate()
+                                          : !rhs.IsImmediate() && rhs.Inst() < lhs.Inst()};
+        if (swap) {
+            std::swap(lhs, rhs);
+        }
+    }
+    return expression;
+}
+
+/// Computes the immediate dominator of each block, indexed by post order
+std::vector<size_t> ImmediateDominators(const IR::BlockList& post_order_blocks) {
+    const size_t num_blocks{post_order_blocks.size()};
+    std::unordered_map<const IR::Block*, size_t> post_order_index;
+    for (size_t index = 0; index < num_blocks; ++index) {
+        post_order_index.emplace(post_order_blocks[index], index);
+    }
+    const auto intersect{[](const std::vector<size_t>& idoms, size_t lhs, size_t rhs) {
+        while (lhs != rhs) {
+            while (lhs < rhs) {
+                lhs = idoms[lhs];
+            }
+            while (rhs < lhs) {
+                rhs = idoms[rhs];
+            }
+        }
+        return lhs;
+    }};
+    // The entry block is the last block in post order
+    std::vector<size_t> idoms(num_blocks, NO_DOMINATOR);
+    idoms[num_blocks - 1] = num_blocks - 1;
+    bool changed{true};
+    while (changed) {
+        changed = false;
+        for (size_t index = num_blocks - 1; index-- > 0;) {
+            size_t new_idom{NO_DOMINATOR};
+            for (const IR::Block* const pred : post_order_blocks[index]->ImmPredecessors()) {
+                const auto it{post_order_index.find(pred)};
+                if (it == post_order_index.end() || idoms[it->second] == NO_DOMINATOR) {
+                    // Unreachable or not processed yet
+                    continue;
+                }
+                new_idom = new_idom == NO_DOMINATOR ? it->second
+                                                    : intersect(idoms, it->second, new_idom);
+            }
+            if (idoms[index] != new_idom) {
+                idoms[index] = new_idom;
+                changed = true;
+            }
+        }
+    }
+    return idoms;
+}
+} // Anonymous namespace
+
+void GlobalValueNumberingPass(IR::Program& program) {
+    const IR::BlockList& post_order_blocks{program.post_order_blocks};
+    if (post_order_blocks.empty()) {
+        return;
+    }
+    const size_t num_blocks{post_order_blocks.size()};
+    const std::vector<size_t> idoms{ImmediateDominators(post_order_blocks)};
+    std::vector<std::vector<size_t>> children(num_blocks);
+    for (size_t index = num_blocks - 1; index-- > 0;) {
+        if (idoms[index] != NO_DOMINATOR) {
+            children[idoms[index]].push_back(index);
+        }
+    }
+    // Walk the dominator tree in preorder, expressions are visible to the dominated blocks only
+    std::unordered_map<Expression, IR::Inst*, ExpressionHash> available;
+    std::vector<Expression> scope_expressions;
+    struct Scope {
+        size_t block;
+        size_t next_child;
+        size_t num_expressions;
+    };
+    std::vector<Scope> scopes;
+    const auto enter{[&](size_t index) {
+        scopes.push_back(Scope{index, 0, scope_expressions.size()});
+        for (IR::Inst& inst : post_order_blocks[index]->Instructions()) {
+            if (!IsNumberable(inst)) {
+                continue;
+            }
+            Expression expression{MakeExpression(inst)};
+            const auto [it, inserted]{available.try_emplace(expression, &inst)};
+            if (inserted) {
+                scope_expressions.push_back(std::move(expression));
+            } else {
+                inst.ReplaceUsesWith(IR::Value{it->second});
+            }
+        }
+    }};
+    enter(num_blocks - 1);
+    while (!scopes.empty()) {
+        Scope& scope{scopes.back()};
+        const std::vector<size_t>& block_children{children[scope.block]};
+        if (scope.next_child < block_children.size()) {
+            enter(block_children[scope.next_child++]);
+            continue;
+        }
+        while (scope_expressions.size() > scope.num_expressions) {
+            available.erase(scope_expressions.back());
+            scope_expressions.pop_back();
+        }
+        scopes.pop_back();
+    }
+}
+
+} // namespace Shader::Optimization
@@ -0,0 +1,502 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file implements sparse conditional constant propagation as described in the following
+// paper: Wegman, M. N. and Zadeck, F. K. 1991. Constant propagation with conditional branches.
+// ACM Trans. Program. Lang. Syst. 13, 2 (Apr. 1991), 181-210.
+//
+// Unlike ConstantPropagationPass, values are propagated through phi nodes and branch conditions,
+// so constants flowing around loops or only through the taken side of a branch are discovered.
+
+#include <algorithm>
+#include <optional>
+#include <set>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "common/bit_cast.h"
+#include "common/common_types.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+/// Lattice value of an instruction, it only moves from undefined to constant to overdefined
+struct LatticeValue {
+    enum class State {
+        Undefined,
+        Constant,
+        Overdefined,
+    };
+
+    [[nodiscard]] static LatticeValue Overdefined() {
+        return LatticeValue{State::Overdefined, {}};
+    }
+
+    [[nodiscard]] bool IsUndefined() const noexcept {
+        return state == State::Undefined;
+    }
+    [[nodiscard]] bool IsConstant() const noexcept {
+        return state == State::Constant;
+    }
+    [[nodiscard]] bool IsOverdefined() const noexcept {
+        return state == State::Overdefined;
+    }
+
+    [[nodiscard]] bool operator==(const LatticeValue& other) const {
+        return state == other.state && (state != State::Constant || constant == other.constant);
+    }
+
+    State state{State::Undefined};
+    IR::Value constant;
+};
+
+[[nodiscard]] LatticeValue Meet(const LatticeValue& lhs, const LatticeValue& rhs) {
+    if (lhs.IsUndefined()) {
+        return rhs;
+    }
+    if (rhs.IsUndefined()) {
+        return lhs;
+    }
+    if (lhs.IsConstant() && rhs.IsConstant() && lhs.constant == rhs.constant) {
+        return lhs;
+    }
+    return LatticeValue::Overdefined();
+}
+
+/// Two-way branch at the end of a block, described by the structured syntax list
+struct Branch {
+    IR::Value cond;
+    IR::Block* true_block;
+    IR::Block* false_block;
+};
+
+std::unordered_map<IR::Block*, Branch> CollectBranches(const IR::Program& program) {
+    std::unordered_map<IR::Block*, Branch> branches;
+    const IR::AbstractSyntaxList& syntax_list{program.syntax_list};
+    for (size_t index = 1; index < syntax_list.size(); ++index) {
+        const IR::AbstractSyntaxNode& node{syntax_list[index]};
+        const IR::AbstractSyntaxNode& previous{syntax_list[index - 1]};
+        if (previous.type != IR::AbstractSyntaxNode::Type::Block) {
+            continue;
+        }
+        Branch branch;
+        switch (node.type) {
+        case IR::AbstractSyntaxNode::Type::If:
+            branch = {node.data.if_node.cond, node.data.if_node.body, node.data.if_node.merge};
+            break;
+        case IR::AbstractSyntaxNode::Type::Repeat:
+            branch = {node.data.repeat.cond, node.data.repeat.loop_header,
+                      node.data.repeat.merge};
+            break;
+        case IR::AbstractSyntaxNode::Type::Break:
+            branch = {node.data.break_node.cond, node.data.break_node.merge,
+                      node.data.break_node.skip};
+            break;
+        default:
+            continue;
+        }
+        // Only trust the node when it describes the successors of the preceding block
+        IR::Block* const block{previous.data.block};
+        const auto successors{block->ImmSuccessors()};
+        if (branch.true_block == branch.false_block || successors.size() != 2 ||
+            std::ranges::find(successors, branch.true_block) == successors.end() ||
+            std::ranges::find(successors, branch.false_block) == successors.end()) {
+            continue;
+        }
+        branches.emplace(block, branch);
+    }
+    return branches;
+}
+
+template <typename Func>
+std::optional<IR::Value> FoldU32(const IR::Value& a, Func&& func) {
+    if (a.Type() != IR::Type::U32) {
+        return std::nullopt;
+    }
+    return IR::Value{func(a.U32())};
+}
+
+template <typename Func>
+std::optional<IR::Value> FoldU32(const IR::Value& a, const IR::Value& b, Func&& func) {
+    if (a.Type() != IR::Type::U32 || b.Type() != IR::Type::U32) {
+        return std::nullopt;
+    }
+    return IR::Value{func(a.U32(), b.U32())};
+}
+
+template <typename Func>
+std::optional<IR::Value> FoldS32(const IR::Value& a, const IR::Value& b, Func&& func) {
+    if (a.Type() != IR::Type::U32 || b.Type() != IR::Type::U32) {
+        return std::nullopt;
+    }
+    return IR::Value{func(static_cast<s32>(a.U32()), static_cast<s32>(b.U32()))};
+}
+
+template <typename Func>
+std::optional<IR::Value> FoldShift(const IR::Value& a, const IR::Value& b, Func&& func) {
+    if (a.Type() != IR::Type::U32 || b.Type() != IR::Type::U32 || b.U32() >= 32) {
+        // Shifts by the bit width or more are undefined on the host
+        return std::nullopt;
+    }
+    return IR::Value{func(a.U32(), b.U32())};
+}
+
+template <typename Func>
+std::optional<IR::Value> FoldU1(const IR::Value& a, const IR::Value& b, Func&& func) {
+    if (a.Type() != IR::Type::U1 || b.Type() != IR::Type::U1) {
+        return std::nullopt;
+    }
+    return IR::Value{func(a.U1(), b.U1())};
+}
+
+/// Folds an instruction with constant arguments, returns nullopt when it can't be evaluated
+std::optional<IR::Value> FoldConstants(IR::Opcode opcode, std::span<const IR::Value> args) {
+    switch (opcode) {
+    case IR::Opcode::IAdd32:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a + b; });
+    case IR::Opcode::ISub32:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a - b; });
+    case IR::Opcode::IMul32:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a * b; });
+    case IR::Opcode::INeg32:
+        return FoldU32(args[0], [](u32 a) { return 0U - a; });
+    case IR::Opcode::BitwiseAnd32:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a & b; });
+    case IR::Opcode::BitwiseOr32:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a | b; });
+    case IR::Opcode::BitwiseXor32:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a ^ b; });
+    case IR::Opcode::BitwiseNot32:
+        return FoldU32(args[0], [](u32 a) { return ~a; });
+    case IR::Opcode::ShiftLeftLogical32:
+        return FoldShift(args[0], args[1], [](u32 a, u32 b) { return a << b; });
+    case IR::Opcode::ShiftRightLogical32:
+        return FoldShift(args[0], args[1], [](u32 a, u32 b) { return a >> b; });
+    case IR::Opcode::ShiftRightArithmetic32:
+        return FoldShift(args[0], args[1], [](u32 a, u32 b) {
+            return static_cast<u32>(static_cast<s32>(a) >> b);
+        });
+    case IR::Opcode::SMin32:
+        return FoldS32(args[0], args[1],
+                       [](s32 a, s32 b) { return static_cast<u32>(std::min(a, b)); });
+    case IR::Opcode::UMin32:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return std::min(a, b); });
+    case IR::Opcode::SMax32:
+        return FoldS32(args[0], args[1],
+                       [](s32 a, s32 b) { return static_cast<u32>(std::max(a, b)); });
+    case IR::Opcode::UMax32:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return std::max(a, b); });
+    case IR::Opcode::IEqual:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a == b; });
+    case IR::Opcode::INotEqual:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a != b; });
+    case IR::Opcode::SLessThan:
+        return FoldS32(args[0], args[1], [](s32 a, s32 b) { return a < b; });
+    case IR::Opcode::ULessThan:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a < b; });
+    case IR::Opcode::SLessThanEqual:
+        return FoldS32(args[0], args[1], [](s32 a, s32 b) { return a <= b; });
+    case IR::Opcode::ULessThanEqual:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a <= b; });
+    case IR::Opcode::SGreaterThan:
+        return FoldS32(args[0], args[1], [](s32 a, s32 b) { return a > b; });
+    case IR::Opcode::UGreaterThan:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a > b; });
+    case IR::Opcode::SGreaterThanEqual:
+        return FoldS32(args[0], args[1], [](s32 a, s32 b) { return a >= b; });
+    case IR::Opcode::UGreaterThanEqual:
+        return FoldU32(args[0], args[1], [](u32 a, u32 b) { return a >= b; });
+    case IR::Opcode::LogicalOr:
+        return FoldU1(args[0], args[1], [](bool a, bool b) { return a || b; });
+    case IR::Opcode::LogicalAnd:
+        return FoldU1(args[0], args[1], [](bool a, bool b) { return a && b; });
+    case IR::Opcode::LogicalXor:
+        return FoldU1(args[0], args[1], [](bool a, bool b) { return a != b; });
+    case IR::Opcode::LogicalNot:
+        if (args[0].Type() != IR::Type::U1) {
+            return std::nullopt;
+        }
+        return IR::Value{!args[0].U1()};
+    case IR::Opcode::BitCastU32F32:
+        if (args[0].Type() != IR::Type::F32) {
+            return std::nullopt;
+        }
+        return IR::Value{Common::BitCast<u32>(args[0].F32())};
+    case IR::Opcode::BitCastF32U32:
+        if (args[0].Type() != IR::Type::U32) {
+            return std::nullopt;
+        }
+        return IR::Value{Common::BitCast<f32>(args[0].U32())};
+    default:
+        return std::nullopt;
+    }
+}
+
+bool IsSelect(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::SelectU1:
+    case IR::Opcode::SelectU8:
+    case IR::Opcode::SelectU16:
+    case IR::Opcode::SelectU32:
+    case IR::Opcode::SelectU64:
+    case IR::Opcode::SelectF16:
+    case IR::Opcode::SelectF32:
+    case IR::Opcode::SelectF64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+class Solver {
+public:
+    explicit Solver(IR::Program& program) : branches{CollectBranches(program)} {
+        for (IR::Block* const block : program.post_order_blocks) {
+            for (IR::Inst& inst : block->Instructions()) {
+                inst_blocks.emplace(&inst, block);
+                const size_t num_args{inst.NumArgs()};
+                for (size_t arg_index = 0; arg_index < num_args; ++arg_index) {
+                    const IR::Value arg{inst.Arg(arg_index).Resolve()};
+                    if (!arg.IsImmediate()) {
+                        users[arg.Inst()].push_back(&inst);
+                    }
+                }
+            }
+        }
+        for (const auto& [block, branch] : branches) {
+            const IR::Value cond{branch.cond.Resolve()};
+            if (!cond.IsImmediate()) {
+                branch_users[cond.Inst()].push_back(block);
+            }
+        }
+    }
+
+    void Run(IR::Block* entry_block) {
+        edge_worklist.emplace_back(nullptr, entry_block);
+        while (!edge_worklist.empty() || !inst_worklist.empty()) {
+            while (!edge_worklist.empty()) {
+                const auto [pred, block]{edge_worklist.back()};
+                edge_worklist.pop_back();
+                VisitEdge(pred, block);
+            }
+            while (!inst_worklist.empty()) {
+                IR::Inst* const inst{inst_worklist.back()};
+                inst_worklist.pop_back();
+                if (executable_blocks.contains(inst_blocks.at(inst))) {
+                    VisitInst(*inst);
+                }
+            }
+        }
+    }
+
+    void Rewrite(IR::Program& program) {
+        std::vector<std::pair<IR::Inst*, IR::Value>> replacements;
+        for (IR::Block* const block : program.post_order_blocks) {
+            for (IR::Inst& inst : block->Instructions()) {
+                const auto it{lattice.find(&inst)};
+                if (it == lattice.end() || !it->second.IsConstant()) {
+                    continue;
+                }
+                const IR::Value& constant{it->second.constant};
+                // Condition references are kept alive for the syntax list, their argument is
+                // folded instead
+                if (!constant.IsImmediate() || inst.GetOpcode() == IR::Opcode::ConditionRef ||
+                    inst.GetOpcode() == IR::Opcode::Identity || inst.Type() != constant.Type()) {
+                    continue;
+                }
+                replacements.emplace_back(&inst, constant);
+            }
+        }
+        for (const auto& [inst, constant] : replacements) {
+            if (IR::IsPhi(*inst)) {
+                // Phi nodes have to stay at the beginning of their block
+                IR::Block::InstructionList& list{inst_blocks.at(inst)->Instructions()};
+                list.erase(IR::Block::InstructionList::s_iterator_to(*inst));
+                list.insert(std::ranges::find_if_not(list, IR::IsPhi), *inst);
+            }
+            inst->ReplaceUsesWith(constant);
+        }
+    }
+
+private:
+    [[nodiscard]] LatticeValue Lookup(const IR::Value& value) const {
+        const IR::Value resolved{value.Resolve()};
+        if (resolved.IsImmediate()) {
+            return LatticeValue{LatticeValue::State::Constant, resolved};
+        }
+        const auto it{lattice.find(resolved.Inst())};
+        return it != lattice.end() ? it->second : LatticeValue{};
+    }
+
+    void VisitEdge(IR::Block* pred, IR::Block* block) {
+        if (pred && !executable_edges.emplace(pred, block).second) {
+            return;
+        }
+        if (!executable_blocks.insert(block).second) {
+            // The block has already been visited, only its phi nodes depend on the new edge
+            for (IR::Inst& phi : block->Instructions()) {
+                if (!IR::IsPhi(phi)) {
+                    break;
+                }
+                VisitInst(phi);
+            }
+            return;
+        }
+        for (IR::Inst& inst : block->Instructions()) {
+            VisitInst(inst);
+        }
+        VisitBranch(block);
+    }
+
+    void VisitBranch(IR::Block* block) {
+        const auto it{branches.find(block)};
+        if (it == branches.end()) {
+            for (IR::Block* const successor : block->ImmSuccessors()) {
+                edge_worklist.emplace_back(block, successor);
+            }
+            return;
+        }
+        const Branch& branch{it->second};
+        const LatticeValue cond{Lookup(branch.cond)};
+        if (cond.IsUndefined()) {
+            return;
+        }
+        if (cond.IsConstant() && cond.constant.Type() == IR::Type::U1) {
+            const bool taken{cond.constant.U1()};
+            edge_worklist.emplace_back(block, taken ? branch.true_block : branch.false_block);
+            return;
+        }
+        edge_worklist.emplace_back(block, branch.true_block);
+        edge_worklist.emplace_back(block, branch.false_block);
+    }
+
+    void VisitInst(IR::Inst& inst) {
+        LatticeValue& current{lattice[&inst]};
+        if (current.IsOverdefined()) {
+            return;
+        }
+        const LatticeValue value{Meet(current, Evaluate(inst))};
+        if (value == current) {
+            return;
+        }
+        current = value;
+        if (const auto it{users.find(&inst)}; it != users.end()) {
+            inst_worklist.insert(inst_worklist.end(), it->second.begin(), it->second.end());
+        }
+        if (const auto it{branch_users.find(&inst)}; it != branch_users.end()) {
+            for (IR::Block* const block : it->second) {
+                if (executable_blocks.contains(block)) {
+                    VisitBranch(block);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] LatticeValue Evaluate(IR::Inst& inst) const {
+        const IR::Opcode opcode{inst.GetOpcode()};
+        if (opcode == IR::Opcode::Phi) {
+            IR::Block* const block{inst_blocks.at(&inst)};
+            LatticeValue result;
+            const size_t num_args{inst.NumArgs()};
+            for (size_t arg_index = 0; arg_index < num_args && !result.IsOverdefined();
+                 ++arg_index) {
+                // Values flowing through edges that are never taken are ignored
+                if (executable_edges.contains({inst.PhiBlock(arg_index), block})) {
+                    result = Meet(result, Lookup(inst.Arg(arg_index)));
+                }
+            }
+            return result;
+        }
+        if (opcode == IR::Opcode::Identity || opcode == IR::Opcode::ConditionRef) {
+            return Lookup(inst.Arg(0));
+        }
+        if (inst.HasAssociatedPseudoOperation()) {
+            return LatticeValue::Overdefined();
+        }
+        if (IsSelect(opcode)) {
+            const LatticeValue cond{Lookup(inst.Arg(0))};
+            if (cond.IsUndefined()) {
+                return cond;
+            }
+            if (cond.IsConstant() && cond.constant.Type() == IR::Type::U1) {
+                return Lookup(inst.Arg(cond.constant.U1() ? 1 : 2));
+            }
+            return Meet(Lookup(inst.Arg(1)), Lookup(inst.Arg(2)));
+        }
+        const size_t num_args{inst.NumArgs()};
+        boost::container::small_vector<IR::Value, 3> args;
+        bool has_undefined{};
+        for (size_t arg_index = 0; arg_index < num_args; ++arg_index) {
+            const LatticeValue arg{Lookup(inst.Arg(arg_index))};
+            if (arg.IsOverdefined()) {
+                return ShortCircuit(inst);
+            }
+            has_undefined |= arg.IsUndefined();
+            args.push_back(arg.constant);
+        }
+        if (has_undefined) {
+            return LatticeValue{};
+        }
+        const std::optional<IR::Value> result{FoldConstants(opcode, {args.data(), args.size()})};
+        if (!result) {
+            return LatticeValue::Overdefined();
+        }
+        return LatticeValue{LatticeValue::State::Constant, *result};
+    }
+
+    /// Logical operations with a dominant constant operand don't depend on the other one
+    [[nodiscard]] LatticeValue ShortCircuit(const IR::Inst& inst) const {
+        bool dominant;
+        switch (inst.GetOpcode()) {
+        case IR::Opcode::LogicalAnd:
+            dominant = false;
+            break;
+        case IR::Opcode::LogicalOr:
+            dominant = true;
+            break;
+        default:
+            return LatticeValue::Overdefined();
+        }
+        for (size_t arg_index = 0; arg_index < 2; ++arg_index) {
+            const LatticeValue arg{Lookup(inst.Arg(arg_index))};
+            if (arg.IsConstant() && arg.constant.Type() == IR::Type::U1 &&
+                arg.constant.U1() == dominant) {
+                return arg;
+            }
+        }
+        return LatticeValue::Overdefined();
+    }
+
+    std::unordered_map<IR::Block*, Branch> branches;
+    std::unordered_map<IR::Inst*, IR::Block*> inst_blocks;
+    std::unordered_map<IR::Inst*, boost::container::small_vector<IR::Inst*, 4>> users;
+    std::unordered_map<IR::Inst*, boost::container::small_vector<IR::Block*, 1>> branch_users;
+    std::unordered_map<IR::Inst*, LatticeValue> lattice;
+
+    std::unordered_set<IR::Block*> executable_blocks;
+    std::set<std::pair<IR::Block*, IR::Block*>> executable_edges;
+
+    std::vector<std::pair<IR::Block*, IR::Block*>> edge_worklist;
+    std::vector<IR::Inst*> inst_worklist;
+};
+} // Anonymous namespace
+
+void SparseConditionalConstantPropagationPass(IR::Program& program) {
+    if (program.syntax_list.empty() ||
+        program.syntax_list.front().type != IR::AbstractSyntaxNode::Type::Block) {
+        return;
+    }
+    Solver solver{program};
+    solver.Run(program.syntax_list.front().data.block);
+    solver.Rewrite(program);
+}
+
+} // namespace Shader::Optimization
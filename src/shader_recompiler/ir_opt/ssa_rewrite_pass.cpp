@@ -13,16 +13,20 @@
 //      https://link.springer.com/chapter/10.1007/978-3-642-37051-9_6
 //
 
+#include <algorithm>
+#include <array>
 #include <deque>
-#include <map>
 #include <span>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/opcodes.h"
 #include "shader_recompiler/frontend/ir/pred.h"
+#include "shader_recompiler/frontend/ir/program.h"
 #include "shader_recompiler/frontend/ir/reg.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/ir_opt/passes.h"
@@ -52,9 +56,49 @@ struct IndirectBranchVariable {
 
 using Variant = std::variant<IR::Reg, IR::Pred, ZeroFlagTag, SignFlagTag, CarryFlagTag,
                              OverflowFlagTag, GotoVariable, IndirectBranchVariable>;
-using ValueMap = std::unordered_map<IR::Block*, IR::Value>;
+
+// Predicates, flags and the indirect branch variable are stored densely for each block
+constexpr size_t VariableIndex(IR::Pred pred) noexcept {
+    return IR::PredIndex(pred);
+}
+constexpr size_t VariableIndex(ZeroFlagTag) noexcept {
+    return IR::NUM_USER_PREDS + 0;
+}
+constexpr size_t VariableIndex(SignFlagTag) noexcept {
+    return IR::NUM_USER_PREDS + 1;
+}
+constexpr size_t VariableIndex(CarryFlagTag) noexcept {
+    return IR::NUM_USER_PREDS + 2;
+}
+constexpr size_t VariableIndex(OverflowFlagTag) noexcept {
+    return IR::NUM_USER_PREDS + 3;
+}
+constexpr size_t VariableIndex(IndirectBranchVariable) noexcept {
+    return IR::NUM_USER_PREDS + 4;
+}
+constexpr size_t NUM_BLOCK_VARIABLES = IR::NUM_USER_PREDS + 5;
+
+/// Blocks are indexed by their order, which is unique for every block in the program
+size_t BlockIndex(const IR::Block* block) noexcept {
+    return block->GetOrder();
+}
+
+size_t NumBlockIndices(const IR::Program& program) {
+    // Unreachable blocks removed from the program can still be predecessors of reachable blocks,
+    // they keep their original order so they have to be accounted for
+    size_t num_indices{};
+    for (const IR::Block* const block : program.post_order_blocks) {
+        num_indices = std::max(num_indices, BlockIndex(block) + 1);
+        for (const IR::Block* const imm_pred : block->ImmPredecessors()) {
+            num_indices = std::max(num_indices, BlockIndex(imm_pred) + 1);
+        }
+    }
+    return num_indices;
+}
 
 struct DefTable {
+    explicit DefTable(size_t num_blocks_) : num_blocks{num_blocks_}, block_defs(num_blocks_) {}
+
     const IR::Value& Def(IR::Block* block, IR::Reg variable) {
         return block->SsaRegValue(variable);
     }
@@ -62,62 +106,38 @@ struct DefTable {
         block->SetSsaRegValue(variable, value);
     }
 
-    const IR::Value& Def(IR::Block* block, IR::Pred variable) {
-        return preds[IR::PredIndex(variable)][block];
-    }
-    void SetDef(IR::Block* block, IR::Pred variable, const IR::Value& value) {
-        preds[IR::PredIndex(variable)].insert_or_assign(block, value);
-    }
-
     const IR::Value& Def(IR::Block* block, GotoVariable variable) {
-        return goto_vars[variable.index][block];
+        return GotoDefs(variable.index)[BlockIndex(block)];
     }
     void SetDef(IR::Block* block, GotoVariable variable, const IR::Value& value) {
-        goto_vars[variable.index].insert_or_assign(block, value);
-    }
-
-    const IR::Value& Def(IR::Block* block, IndirectBranchVariable) {
-        return indirect_branch_var[block];
-    }
-    void SetDef(IR::Block* block, IndirectBranchVariable, const IR::Value& value) {
-        indirect_branch_var.insert_or_assign(block, value);
-    }
-
-    const IR::Value& Def(IR::Block* block, ZeroFlagTag) {
-        return zero_flag[block];
-    }
-    void SetDef(IR::Block* block, ZeroFlagTag, const IR::Value& value) {
-        zero_flag.insert_or_assign(block, value);
+        GotoDefs(variable.index)[BlockIndex(block)] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, SignFlagTag) {
-        return sign_flag[block];
-    }
-    void SetDef(IR::Block* block, SignFlagTag, const IR::Value& value) {
-        sign_flag.insert_or_assign(block, value);
-    }
-
-    const IR::Value& Def(IR::Block* block, CarryFlagTag) {
-        return carry_flag[block];
+    template <typename Type>
+    const IR::Value& Def(IR::Block* block, Type variable) {
+        return block_defs[BlockIndex(block)][VariableIndex(variable)];
     }
-    void SetDef(IR::Block* block, CarryFlagTag, const IR::Value& value) {
-        carry_flag.insert_or_assign(block, value);
+    template <typename Type>
+    void SetDef(IR::Block* block, Type variable, const IR::Value& value) {
+        block_defs[BlockIndex(block)][VariableIndex(variable)] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, OverflowFlagTag) {
-        return overflow_flag[block];
-    }
-    void SetDef(IR::Block* block, OverflowFlagTag, const IR::Value& value) {
-        overflow_flag.insert_or_assign(block, value);
+private:
+    std::vector<IR::Value>& GotoDefs(u32 index) {
+        // Goto variables are numbered sequentially, so a vector indexed by them stays small
+        if (index >= goto_vars.size()) {
+            goto_vars.resize(index + 1);
+        }
+        std::vector<IR::Value>& defs{goto_vars[index]};
+        if (defs.empty()) {
+            defs.resize(num_blocks);
+        }
+        return defs;
     }
 
-    std::array<ValueMap, IR::NUM_USER_PREDS> preds;
-    std::unordered_map<u32, ValueMap> goto_vars;
-    ValueMap indirect_branch_var;
-    ValueMap zero_flag;
-    ValueMap sign_flag;
-    ValueMap carry_flag;
-    ValueMap overflow_flag;
+    size_t num_blocks;
+    std::vector<std::array<IR::Value, NUM_BLOCK_VARIABLES>> block_defs;
+    std::vector<std::vector<IR::Value>> goto_vars;
 };
 
 IR::Opcode UndefOpcode(IR::Reg) noexcept {
@@ -158,6 +178,8 @@ struct ReadState {
 
 class Pass {
 public:
+    explicit Pass(size_t num_blocks) : incomplete_phis(num_blocks), current_def{num_blocks} {}
+
     template <typename Type>
     void WriteVariable(Type variable, IR::Block* block, const IR::Value& value) {
         current_def.SetDef(block, variable, value);
@@ -194,7 +216,7 @@ public:
                     IR::Inst* phi{&*block->PrependNewInst(block->begin(), IR::Opcode::Phi)};
                     phi->SetFlags(IR::TypeOf(UndefOpcode(variable)));
 
-                    incomplete_phis[block].insert_or_assign(variable, phi);
+                    incomplete_phis[BlockIndex(block)].emplace_back(variable, phi);
                     stack.back().result = IR::Value{&*phi};
                 } else if (const std::span imm_preds = block->ImmPredecessors();
                            imm_preds.size() == 1) {
@@ -239,17 +261,57 @@ public:
     }
 
     void SealBlock(IR::Block* block) {
-        const auto it{incomplete_phis.find(block)};
-        if (it != incomplete_phis.end()) {
-            for (auto& pair : it->second) {
-                auto& variant{pair.first};
-                auto& phi{pair.second};
-                std::visit([&](auto& variable) { AddPhiOperands(variable, *phi, block); }, variant);
-            }
+        auto& phis{incomplete_phis[BlockIndex(block)]};
+        // Resolve incomplete phis in a deterministic order regardless of how they were created
+        std::ranges::sort(phis, {}, &std::pair<Variant, IR::Inst*>::first);
+        for (auto& [variant, phi] : phis) {
+            std::visit([&](auto& variable) { AddPhiOperands(variable, *phi, block); }, variant);
         }
+        phis.clear();
         block->SsaSeal();
     }
 
+    void RemoveTrivialPhis(std::span<IR::Block* const> blocks) {
+        // Removing a trivial phi can make the phis using it trivial too, these are tracked with a
+        // worklist instead of recursing through the users
+        std::unordered_map<IR::Inst*, boost::container::small_vector<IR::Inst*, 2>> phi_users;
+        std::unordered_map<IR::Inst*, IR::Block*> phi_blocks;
+        std::vector<IR::Inst*> worklist;
+        for (IR::Block* const block : blocks) {
+            for (IR::Inst& phi : block->Instructions()) {
+                if (!IR::IsPhi(phi)) {
+                    break;
+                }
+                phi_blocks.emplace(&phi, block);
+                worklist.push_back(&phi);
+                const size_t num_args{phi.NumArgs()};
+                for (size_t arg_index = 0; arg_index < num_args; ++arg_index) {
+                    const IR::Value arg{phi.Arg(arg_index).Resolve()};
+                    if (!arg.IsImmediate() && IR::IsPhi(*arg.Inst()) && arg.Inst() != &phi) {
+                        phi_users[arg.Inst()].push_back(&phi);
+                    }
+                }
+            }
+        }
+        while (!worklist.empty()) {
+            IR::Inst* const phi{worklist.back()};
+            worklist.pop_back();
+            if (!IR::IsPhi(*phi)) {
+                // Already removed
+                continue;
+            }
+            const IR::Opcode undef_opcode{phi->Type() == IR::Type::U1 ? IR::Opcode::UndefU1
+                                                                      : IR::Opcode::UndefU32};
+            if (TryRemoveTrivialPhi(*phi, phi_blocks.at(phi), undef_opcode) == IR::Value{phi}) {
+                continue;
+            }
+            const auto it{phi_users.find(phi)};
+            if (it != phi_users.end()) {
+                worklist.insert(worklist.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+
 private:
     template <typename Type>
     IR::Value AddPhiOperands(Type variable, IR::Inst& phi, IR::Block* block) {
@@ -291,11 +353,11 @@ private:
         // Reinsert the phi node and reroute all its uses to the "same" value
         list.insert(reinsert_point, phi);
         phi.ReplaceUsesWith(same);
-        // TODO: Try to recursively remove all phi users, which might have become trivial
+        // Phi users which might have become trivial are removed by RemoveTrivialPhis
         return same;
     }
 
-    std::unordered_map<IR::Block*, std::map<Variant, IR::Inst*>> incomplete_phis;
+    std::vector<boost::container::small_vector<std::pair<Variant, IR::Inst*>, 4>> incomplete_phis;
     DefTable current_def;
 };
 
@@ -391,11 +453,12 @@ IR::Type GetConcreteType(IR::Inst* inst) {
 } // Anonymous namespace
 
 void SsaRewritePass(IR::Program& program) {
-    Pass pass;
+    Pass pass(NumBlockIndices(program));
     const auto end{program.post_order_blocks.rend()};
     for (auto block = program.post_order_blocks.rbegin(); block != end; ++block) {
         VisitBlock(pass, *block);
     }
+    pass.RemoveTrivialPhis(program.post_order_blocks);
     for (auto block = program.post_order_blocks.rbegin(); block != end; ++block) {
         for (IR::Inst& inst : (*block)->Instructions()) {
             if (inst.GetOpcode() == IR::Opcode::Phi) {
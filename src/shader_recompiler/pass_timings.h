@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Shader {
+
+/// Host time spent in each stage of a shader translation, collected when profiling the recompiler
+class PassTimings {
+public:
+    struct Entry {
+        std::string_view name; ///< Static string naming the pass
+        std::chrono::nanoseconds time{};
+    };
+
+    /// Runs a pass and accumulates its execution time under the given name
+    template <typename Func>
+    void Measure(std::string_view name, Func&& func) {
+        const auto start{std::chrono::steady_clock::now()};
+        std::forward<Func>(func)();
+        Add(name, std::chrono::steady_clock::now() - start);
+    }
+
+    void Add(std::string_view name, std::chrono::nanoseconds time) {
+        // There are only a handful of passes, a linear search is faster than a map
+        for (Entry& entry : entries) {
+            if (entry.name == name) {
+                entry.time += time;
+                return;
+            }
+        }
+        entries.push_back(Entry{name, time});
+    }
+
+    void Merge(const PassTimings& other) {
+        for (const Entry& entry : other.entries) {
+            Add(entry.name, entry.time);
+        }
+    }
+
+    void Clear() noexcept {
+        entries.clear();
+    }
+
+    [[nodiscard]] const std::vector<Entry>& Entries() const noexcept {
+        return entries;
+    }
+
+private:
+    std::vector<Entry> entries;
+};
+
+/// Runs a pass, measuring it only when timings are being collected
+template <typename Func>
+void RunPass(PassTimings* timings, std::string_view name, Func&& func) {
+    if (timings) {
+        timings->Measure(name, std::forward<Func>(func));
+    } else {
+        std::forward<Func>(func)();
+    }
+}
+
+} // namespace Shader
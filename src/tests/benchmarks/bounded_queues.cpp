@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/bounded_threadsafe_queue.h"
+#include "common/common_types.h"
+#include "tests/benchmarks/queue_transfer.h"
+
+using Benchmarks::Transfer;
+
+// The bounded queues share their names with the unbounded ones, so they live in their own file
+
+TEST_CASE("Bounded queues", "[benchmark]") {
+    BENCHMARK("Bounded SPSCQueue, 1 producer") {
+        Common::SPSCQueue<u64> queue;
+        return Transfer(
+            1, 1, [&](u64 value) { queue.EmplaceWait(value); }, [&] { return queue.PopWait(); });
+    };
+
+    BENCHMARK("Bounded MPSCQueue, 4 producers") {
+        Common::MPSCQueue<u64> queue;
+        return Transfer(
+            4, 1, [&](u64 value) { queue.EmplaceWait(value); }, [&] { return queue.PopWait(); });
+    };
+
+    BENCHMARK("Bounded MPMCQueue, 4 producers, 4 consumers") {
+        Common::MPMCQueue<u64> queue;
+        return Transfer(
+            4, 4, [&](u64 value) { queue.EmplaceWait(value); }, [&] { return queue.PopWait(); });
+    };
+}
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "common/multi_level_page_table.h"
+#include "common/range_sets.h"
+#include "common/range_sets.inc"
+#include "common/scratch_buffer.h"
+#include "common/slot_vector.h"
+
+TEST_CASE("CityHash64", "[benchmark]") {
+    std::mt19937 rng{0x2024};
+    std::vector<char> data(1 << 20);
+    for (char& value : data) {
+        value = static_cast<char>(rng());
+    }
+
+    // Shader and pipeline keys are small, guest shaders are kilobytes and textures megabytes
+    BENCHMARK("64 bytes") {
+        return Common::CityHash64(data.data(), 64);
+    };
+    BENCHMARK("4 KiB") {
+        return Common::CityHash64(data.data(), 4096);
+    };
+    BENCHMARK("1 MiB") {
+        return Common::CityHash64(data.data(), data.size());
+    };
+}
+
+TEST_CASE("ScratchBuffer", "[benchmark]") {
+    std::mt19937 rng{0x2024};
+    std::vector<size_t> sizes(1024);
+    for (size_t& size : sizes) {
+        size = rng() % (256 << 10);
+    }
+
+    BENCHMARK("1024 destructive resizes up to 256 KiB") {
+        Common::ScratchBuffer<u8> buffer;
+        u64 sum = 0;
+        for (const size_t size : sizes) {
+            buffer.resize_destructive(size);
+            if (size != 0) {
+                buffer[size - 1] = 1;
+                sum += buffer[size - 1];
+            }
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("RangeSet", "[benchmark]") {
+    // Modified ranges of the buffer cache, mostly small uploads over a large address range
+    std::mt19937 rng{0x2024};
+    std::vector<std::pair<u64, size_t>> ranges(4096);
+    for (auto& [addr, size] : ranges) {
+        addr = (rng() % (1 << 20)) * 256;
+        size = (rng() % 64 + 1) * 256;
+    }
+
+    BENCHMARK("Add 4096 ranges") {
+        Common::RangeSet<u64> set;
+        for (const auto& [addr, size] : ranges) {
+            set.Add(addr, size);
+        }
+        return set.Empty();
+    };
+
+    Common::RangeSet<u64> filled;
+    for (const auto& [addr, size] : ranges) {
+        filled.Add(addr, size);
+    }
+    BENCHMARK("Query 4096 ranges") {
+        u64 total = 0;
+        for (const auto& [addr, size] : ranges) {
+            filled.ForEachInRange(addr, size * 4,
+                                  [&](u64 begin, u64 end) { total += end - begin; });
+        }
+        return total;
+    };
+
+    BENCHMARK("Add and subtract 4096 ranges") {
+        Common::RangeSet<u64> set;
+        for (const auto& [addr, size] : ranges) {
+            set.Add(addr, size);
+        }
+        for (const auto& [addr, size] : ranges) {
+            set.Subtract(addr + 128, size);
+        }
+        return set.Empty();
+    };
+}
+
+TEST_CASE("MultiLevelPageTable", "[benchmark]") {
+    // Same shape as the GPU memory manager page table
+    constexpr size_t ADDRESS_SPACE_BITS = 40;
+    constexpr size_t PAGE_BITS = 12;
+    Common::MultiLevelPageTable<u32> page_table(ADDRESS_SPACE_BITS, 14, PAGE_BITS);
+    std::mt19937 rng{0x2024};
+    std::vector<u64> pages(1 << 16);
+    for (u64& page : pages) {
+        page = rng() % (1ULL << 20);
+    }
+    page_table.ReserveRange(0, (1ULL << 20) << PAGE_BITS);
+
+    BENCHMARK("64k random page writes and reads") {
+        u64 sum = 0;
+        for (const u64 page : pages) {
+            page_table[page] = static_cast<u32>(page);
+        }
+        for (const u64 page : pages) {
+            sum += page_table[page];
+        }
+        return sum;
+    };
+
+    BENCHMARK("Reserve 1 GiB") {
+        Common::MultiLevelPageTable<u32> table(ADDRESS_SPACE_BITS, 14, PAGE_BITS);
+        table.ReserveRange(0, 1ULL << 30);
+        return table.data() != nullptr;
+    };
+}
+
+TEST_CASE("SlotVector", "[benchmark]") {
+    struct Object {
+        u64 address;
+        u64 size;
+    };
+    std::vector<Common::SlotId> ids;
+    ids.reserve(4096);
+
+    BENCHMARK("Insert and erase 4096 objects") {
+        Common::SlotVector<Object> slots;
+        for (u64 index = 0; index < 4096; ++index) {
+            ids.push_back(slots.insert(index, index));
+        }
+        u64 sum = 0;
+        for (const Common::SlotId id : ids) {
+            sum += slots[id].address;
+            slots.erase(id);
+        }
+        ids.clear();
+        return sum;
+    };
+
+    Common::SlotVector<Object> slots;
+    for (u64 index = 0; index < 4096; ++index) {
+        ids.push_back(slots.insert(index, index));
+    }
+    BENCHMARK("Iterate 4096 objects") {
+        u64 sum = 0;
+        for (const auto& [id, object] : slots) {
+            sum += object->size;
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/address_space.h"
+#include "common/common_types.h"
+#include "common/free_range_allocator.h"
+
+TEST_CASE("FreeRangeAllocator allocation patterns", "[benchmark]") {
+    constexpr u32 PAGES = 1U << 20;
+    std::mt19937 rng{0x2024};
+    std::vector<u32> sizes(4096);
+    for (u32& size : sizes) {
+        // Mostly small mappings with a tail of large ones, like guest GPU allocations
+        size = rng() % 8 == 0 ? 1U << (rng() % 10) : rng() % 16 + 1;
+    }
+
+    BENCHMARK("Allocate and free in FIFO order") {
+        Common::FlatAllocator<u32, 0, 32> allocator{1, PAGES};
+        std::vector<u32> addresses(sizes.size());
+        for (int round = 0; round < 4; ++round) {
+            for (size_t index = 0; index < sizes.size(); ++index) {
+                addresses[index] = allocator.Allocate(sizes[index]);
+            }
+            for (size_t index = 0; index < sizes.size(); ++index) {
+                allocator.Free(addresses[index], sizes[index]);
+            }
+        }
+        return allocator.GetVAStart();
+    };
+
+    BENCHMARK("Free every other allocation and refill the holes") {
+        Common::FlatAllocator<u32, 0, 32> allocator{1, PAGES};
+        std::vector<u32> addresses(sizes.size());
+        for (size_t index = 0; index < sizes.size(); ++index) {
+            addresses[index] = allocator.Allocate(sizes[index]);
+        }
+        u32 checksum = 0;
+        for (int round = 0; round < 4; ++round) {
+            for (size_t index = round % 2; index < sizes.size(); index += 2) {
+                allocator.Free(addresses[index], sizes[index]);
+            }
+            for (size_t index = round % 2; index < sizes.size(); index += 2) {
+                addresses[index] = allocator.Allocate(sizes[index]);
+                checksum += addresses[index];
+            }
+        }
+        return checksum;
+    };
+
+    BENCHMARK("Fragmented address space") {
+        Common::FreeRangeAllocator<u32> allocator;
+        allocator.Free(0, PAGES);
+        for (u32 page = 0; page < PAGES; page += 64) {
+            allocator.Reserve(page, page + 32 + page % 31);
+        }
+        u32 checksum = 0;
+        for (const u32 size : sizes) {
+            checksum += allocator.Allocate(size % 32 + 1).value_or(0);
+        }
+        return checksum;
+    };
+}
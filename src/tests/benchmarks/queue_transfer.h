@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Benchmarks {
+
+/// Number of values moved through a queue by each benchmark run
+constexpr u64 NUM_QUEUE_ITEMS = 1 << 16;
+
+/// Pushes NUM_QUEUE_ITEMS values split between producer threads and pops them all from consumer
+/// threads. Returns the sum of the popped values.
+template <typename Push, typename Pop>
+u64 Transfer(size_t num_producers, size_t num_consumers, Push&& push, Pop&& pop) {
+    std::atomic<u64> sum{};
+    {
+        std::vector<std::jthread> threads;
+        for (size_t producer = 0; producer < num_producers; ++producer) {
+            threads.emplace_back([&push, producer, num_producers] {
+                for (u64 value = producer; value < NUM_QUEUE_ITEMS; value += num_producers) {
+                    push(value);
+                }
+            });
+        }
+        for (size_t consumer = 0; consumer < num_consumers; ++consumer) {
+            threads.emplace_back([&pop, &sum, consumer, num_consumers] {
+                u64 local_sum = 0;
+                for (u64 value = consumer; value < NUM_QUEUE_ITEMS; value += num_consumers) {
+                    local_sum += pop();
+                }
+                sum.fetch_add(local_sum, std::memory_order_relaxed);
+            });
+        }
+    }
+    return sum.load(std::memory_order_relaxed);
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <thread>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/ring_buffer.h"
+#include "common/threadsafe_queue.h"
+#include "tests/benchmarks/queue_transfer.h"
+
+using Benchmarks::Transfer;
+
+TEST_CASE("SPSCQueue and MPSCQueue", "[benchmark]") {
+    BENCHMARK("SPSCQueue, 1 producer") {
+        Common::SPSCQueue<u64> queue;
+        return Transfer(
+            1, 1, [&](u64 value) { queue.Push(value); }, [&] { return queue.PopWait(); });
+    };
+
+    BENCHMARK("MPSCQueue, 4 producers") {
+        Common::MPSCQueue<u64> queue;
+        return Transfer(
+            4, 1, [&](u64 value) { queue.Push(value); }, [&] { return queue.PopWait(); });
+    };
+}
+
+TEST_CASE("RingBuffer", "[benchmark]") {
+    // Stereo 16-bit audio in chunks of 240 frames, like the audio renderer output
+    constexpr size_t CHUNK_SIZE = 480;
+    constexpr size_t NUM_CHUNKS = 2048;
+    std::array<s16, CHUNK_SIZE> chunk{};
+    std::ranges::generate(chunk, [value = s16{}]() mutable { return value++; });
+
+    BENCHMARK("RingBuffer<s16, 0x2000>, 1 producer") {
+        Common::RingBuffer<s16, 0x2000> ring;
+        std::jthread producer([&] {
+            for (size_t index = 0; index < NUM_CHUNKS; ++index) {
+                size_t pushed = 0;
+                while (pushed < CHUNK_SIZE) {
+                    const size_t count = ring.Push(chunk.data() + pushed, CHUNK_SIZE - pushed);
+                    if (count == 0) {
+                        std::this_thread::yield();
+                    }
+                    pushed += count;
+                }
+            }
+        });
+        std::array<s16, CHUNK_SIZE> output{};
+        u64 sum = 0;
+        for (size_t popped = 0; popped < CHUNK_SIZE * NUM_CHUNKS;) {
+            const size_t count = ring.Pop(output.data(), output.size());
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+            for (size_t index = 0; index < count; ++index) {
+                sum += static_cast<u16>(output[index]);
+            }
+            popped += count;
+        }
+        return sum;
+    };
+}
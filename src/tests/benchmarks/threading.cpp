@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <memory>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/fiber.h"
+#include "common/thread_worker.h"
+
+TEST_CASE("Fiber", "[benchmark]") {
+    // Guest threads switch to the host thread fiber and back on every core timing event
+    std::shared_ptr<Common::Fiber> thread_fiber = Common::Fiber::ThreadToFiber();
+    std::shared_ptr<Common::Fiber> work_fiber;
+    u64 num_switches = 0;
+    work_fiber = std::make_shared<Common::Fiber>([&] {
+        while (true) {
+            ++num_switches;
+            Common::Fiber::YieldTo(work_fiber, *thread_fiber);
+        }
+    });
+
+    BENCHMARK("1024 round trips between two fibers") {
+        for (int round = 0; round < 1024; ++round) {
+            Common::Fiber::YieldTo(thread_fiber, *work_fiber);
+        }
+        return num_switches;
+    };
+
+    thread_fiber->Exit();
+}
+
+TEST_CASE("ThreadWorker", "[benchmark]") {
+    constexpr size_t NUM_TASKS = 4096;
+
+    for (const size_t num_workers : {1, 4}) {
+        Common::ThreadWorker worker(num_workers, "Benchmark");
+        std::atomic<u64> counter{};
+
+        BENCHMARK(num_workers == 1 ? "4096 small tasks, 1 worker" : "4096 small tasks, 4 workers") {
+            for (size_t task = 0; task < NUM_TASKS; ++task) {
+                worker.QueueWork([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+            worker.WaitForRequests();
+            return counter.load(std::memory_order_relaxed);
+        };
+    }
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/bounded_threadsafe_queue.h"
+#include "common/common_types.h"
+
+TEST_CASE("MPMCQueue: Try operations respect the capacity", "[common]") {
+    Common::MPMCQueue<u32, 4> queue;
+    for (u32 value = 0; value < 4; ++value) {
+        REQUIRE(queue.TryEmplace(value));
+    }
+    REQUIRE(!queue.TryEmplace(4U));
+    u32 value{};
+    REQUIRE(queue.TryPop(value));
+    REQUIRE(value == 0);
+    REQUIRE(queue.TryEmplace(4U));
+    for (u32 expected = 1; expected <= 4; ++expected) {
+        REQUIRE(queue.TryPop(value));
+        REQUIRE(value == expected);
+    }
+    REQUIRE(!queue.TryPop(value));
+}
+
+TEST_CASE("MPMCQueue: Every value is popped once under contention", "[common]") {
+    constexpr u32 NUM_THREADS = 4;
+    constexpr u32 VALUES_PER_THREAD = 50000;
+    Common::MPMCQueue<u32, 64> queue;
+    std::vector<std::atomic<u32>> seen(NUM_THREADS * VALUES_PER_THREAD);
+    {
+        std::vector<std::jthread> threads;
+        for (u32 thread = 0; thread < NUM_THREADS; ++thread) {
+            threads.emplace_back([&queue, thread] {
+                for (u32 index = 0; index < VALUES_PER_THREAD; ++index) {
+                    queue.EmplaceWait(thread * VALUES_PER_THREAD + index);
+                }
+            });
+        }
+        for (u32 thread = 0; thread < NUM_THREADS; ++thread) {
+            threads.emplace_back([&queue, &seen] {
+                // Consumers pop a fixed share, so none of them waits for values left
+                for (u32 popped = 0; popped < VALUES_PER_THREAD; ++popped) {
+                    seen[queue.PopWait()].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+    }
+    for (const auto& count : seen) {
+        REQUIRE(count.load() == 1);
+    }
+}
+
+TEST_CASE("MPMCQueue: Stop requests wake waiting consumers", "[common]") {
+    Common::MPMCQueue<u32, 16> queue;
+    std::atomic<bool> returned{};
+    std::jthread consumer([&](std::stop_token stop_token) {
+        u32 value{};
+        queue.PopWait(value, stop_token);
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(!returned);
+    consumer.request_stop();
+    consumer.join();
+    REQUIRE(returned);
+}
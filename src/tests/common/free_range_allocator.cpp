@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/address_space.h"
+#include "common/free_range_allocator.h"
+#include "common/free_region_manager.h"
+
+namespace {
+using Ranges = std::vector<std::pair<u32, u32>>;
+
+/// Builds the joined free ranges of an allocation bitmap
+template <size_t N>
+Ranges FreeRanges(const std::array<bool, N>& allocated) {
+    Ranges ranges;
+    for (u32 address = 0; address < N; ++address) {
+        if (allocated[address]) {
+            continue;
+        }
+        if (!ranges.empty() && ranges.back().second == address) {
+            ++ranges.back().second;
+        } else {
+            ranges.emplace_back(address, address + 1);
+        }
+    }
+    return ranges;
+}
+
+/// Returns the free ranges of an allocator whose space is [0, limit)
+Ranges Collect(const Common::FreeRangeAllocator<u32>& allocator, u32 limit) {
+    Ranges ranges;
+    for (u32 address = 0; address < limit;) {
+        const u32 size = allocator.FreeSizeAt(address);
+        if (size == 0) {
+            ++address;
+            continue;
+        }
+        ranges.emplace_back(address, address + size);
+        address += size;
+    }
+    return ranges;
+}
+} // Anonymous namespace
+
+TEST_CASE("FreeRangeAllocator: Free coalesces neighbours", "[common]") {
+    Common::FreeRangeAllocator<u32> allocator;
+    REQUIRE(allocator.Free(0x100, 0x200) == std::pair<u32, u32>{0x100, 0x200});
+    REQUIRE(allocator.Free(0x300, 0x400) == std::pair<u32, u32>{0x300, 0x400});
+    REQUIRE(allocator.Free(0x200, 0x300) == std::pair<u32, u32>{0x100, 0x400});
+    REQUIRE(allocator.Free(0x180, 0x380) == std::pair<u32, u32>{0x100, 0x400});
+    const Common::FragmentationReport report = allocator.GetFragmentationReport();
+    REQUIRE(report.free_size == 0x300);
+    REQUIRE(report.largest_free_size == 0x300);
+    REQUIRE(report.num_free_ranges == 1);
+    REQUIRE(report.Fragmentation() == 0.0);
+}
+
+TEST_CASE("FreeRangeAllocator: Reserve splits ranges", "[common]") {
+    Common::FreeRangeAllocator<u32> allocator;
+    allocator.Free(0, 0x1000);
+    allocator.Reserve(0x400, 0x800);
+    REQUIRE(allocator.FreeSizeAt(0) == 0x400);
+    REQUIRE(allocator.FreeSizeAt(0x400) == 0);
+    REQUIRE(allocator.FreeSizeAt(0x900) == 0x700);
+    const Common::FragmentationReport report = allocator.GetFragmentationReport();
+    REQUIRE(report.free_size == 0xC00);
+    REQUIRE(report.largest_free_size == 0x800);
+    REQUIRE(report.num_free_ranges == 2);
+    REQUIRE(report.Fragmentation() > 0.3);
+}
+
+TEST_CASE("FreeRangeAllocator: Allocate finds the ranges that fit", "[common]") {
+    Common::FreeRangeAllocator<u32> allocator;
+    allocator.Free(0x1000, 0x1011);
+    allocator.Free(0x2000, 0x2100);
+    // Only the range in the size class of the request fits exactly
+    REQUIRE(allocator.Allocate(0x11) == 0x1000);
+    REQUIRE(allocator.Allocate(0x11) == 0x2000);
+    REQUIRE(allocator.Allocate(0x100) == std::nullopt);
+    REQUIRE(allocator.Allocate(0xEF) == 0x2011);
+    REQUIRE(allocator.Allocate(1) == std::nullopt);
+    REQUIRE(allocator.Allocate(0) == std::nullopt);
+}
+
+TEST_CASE("FreeRangeAllocator: Random operations match a bitmap", "[common]") {
+    constexpr u32 SIZE = 2048;
+    std::mt19937 rng{0x2024};
+    std::array<bool, SIZE> allocated{};
+    Common::FreeRangeAllocator<u32> allocator;
+    allocator.Free(0, SIZE);
+    for (int iteration = 0; iteration < 4000; ++iteration) {
+        const u32 begin = std::uniform_int_distribution<u32>{0, SIZE - 1}(rng);
+        const u32 size = std::uniform_int_distribution<u32>{1, 96}(rng);
+        const u32 end = std::min(begin + size, SIZE);
+        switch (rng() % 3) {
+        case 0:
+            allocator.Free(begin, end);
+            std::fill(allocated.begin() + begin, allocated.begin() + end, false);
+            break;
+        case 1:
+            allocator.Reserve(begin, end);
+            std::fill(allocated.begin() + begin, allocated.begin() + end, true);
+            break;
+        case 2: {
+            const Ranges free_ranges = FreeRanges(allocated);
+            const bool fits = std::ranges::any_of(free_ranges, [size](const auto& range) {
+                return range.second - range.first >= size;
+            });
+            const std::optional<u32> address = allocator.Allocate(size);
+            REQUIRE(address.has_value() == fits);
+            if (address) {
+                REQUIRE(std::none_of(allocated.begin() + *address,
+                                     allocated.begin() + *address + size, std::identity{}));
+                std::fill(allocated.begin() + *address, allocated.begin() + *address + size, true);
+            }
+            break;
+        }
+        }
+        REQUIRE(Collect(allocator, SIZE) == FreeRanges(allocated));
+    }
+}
+
+TEST_CASE("FreeRegionManager: FreeBlock returns the merged region", "[common]") {
+    Common::FreeRegionManager manager;
+    u8* const base = reinterpret_cast<u8*>(0x10000);
+    manager.SetAddressSpace(base, 0x10000);
+    manager.AllocateBlock(base + 0x1000, 0x3000);
+    manager.FreeBlock(base + 0x1000, 0x1000);
+    const auto [pointer, size] = manager.FreeBlock(base + 0x3000, 0x1000);
+    REQUIRE(pointer == base + 0x3000);
+    REQUIRE(size == 0xD000);
+    const auto [merged_pointer, merged_size] = manager.FreeBlock(base + 0x2000, 0x1000);
+    REQUIRE(merged_pointer == base);
+    REQUIRE(merged_size == 0x10000);
+}
+
+TEST_CASE("FlatAllocator: Allocations don't overlap and reuse freed space", "[common]") {
+    Common::FlatAllocator<u32, 0, 32> allocator{0x10, 0x1010};
+    allocator.AllocateFixed(0x100, 0x100);
+    std::vector<std::pair<u32, u32>> allocations;
+    for (u32 size = 1;; size = size % 64 + 1) {
+        const u32 address = allocator.Allocate(size);
+        if (address == 0) {
+            break;
+        }
+        REQUIRE(address >= 0x10);
+        REQUIRE(address + size <= 0x1010);
+        REQUIRE((address + size <= 0x100 || address >= 0x200));
+        for (const auto& [other, other_size] : allocations) {
+            REQUIRE((address + size <= other || other + other_size <= address));
+        }
+        allocations.emplace_back(address, size);
+    }
+    // Fill the space left after the last allocation that didn't fit
+    while (allocator.Allocate(1) != 0) {
+    }
+    REQUIRE(allocator.GetFragmentationReport().free_size == 0);
+
+    // Freeing two neighbouring allocations makes room for their combined size
+    std::ranges::sort(allocations);
+    const auto [first, first_size] = allocations[4];
+    const auto [second, second_size] = allocations[5];
+    REQUIRE(first + first_size == second);
+    allocator.Free(first, first_size);
+    allocator.Free(second, second_size);
+    REQUIRE(allocator.Allocate(first_size + second_size) == first);
+}
@@ -184,3 +184,44 @@ TEST_CASE("HostMemory: Partial sparse middle unmap and check bindings", "[common
     REQUIRE(ptr[0x0000] == 19);
     REQUIRE(ptr[0x3fff] == 12);
 }
+
+TEST_CASE("HostMemory: Release backing region", "[common]") {
+    HostMemory mem(BACKING_SIZE, VIRTUAL_SIZE);
+    REQUIRE(mem.GetBackingSize() == BACKING_SIZE);
+    REQUIRE(mem.GetCommittedBackingSize() == 0);
+
+    mem.ClearBackingRegion(0x4000, 0x2000, 0xCD);
+    REQUIRE(mem.GetCommittedBackingSize() == 0x2000);
+    REQUIRE(mem.BackingBasePointer()[0x5FFF] == 0xCD);
+
+    mem.ReleaseBackingRegion(0x4000, 0x1000);
+    REQUIRE(mem.GetCommittedBackingSize() == 0x1000);
+    REQUIRE(mem.BackingBasePointer()[0x4000] == 0);
+    REQUIRE(mem.BackingBasePointer()[0x5000] == 0xCD);
+}
+
+TEST_CASE("HostMemory: Lazy zero fill of released backing region", "[common]") {
+    HostMemory mem(BACKING_SIZE, VIRTUAL_SIZE);
+    mem.Map(0x5000, 0x8000, 0x2000, PERMS, HEAP);
+
+    volatile u8* const data = mem.VirtualBasePointer() + 0x5000;
+    mem.ClearBackingRegion(0x8000, 0x2000, 0);
+    data[0x10] = 62;
+    mem.ReleaseBackingRegion(0x8000, 0x2000);
+#ifdef __linux__
+    REQUIRE(mem.GetCommittedBackingSize() == 0);
+#endif
+    REQUIRE(data[0x10] == 0);
+
+    mem.ClearBackingRegion(0x8000, 0x2000, 0);
+    REQUIRE(data[0x10] == 0);
+#ifdef __linux__
+    // The host only commits the pages touched through the mapping, reads included
+    REQUIRE(mem.GetCommittedBackingSize() == 0x1000);
+#else
+    REQUIRE(mem.GetCommittedBackingSize() == 0x2000);
+#endif
+
+    mem.ReleaseBackingRegion(0x8000, 0x2000);
+    REQUIRE(mem.GetCommittedBackingSize() == 0);
+}
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/range_sets.h"
+#include "common/range_sets.inc"
+
+namespace {
+using Ranges = std::vector<std::pair<u64, u64>>;
+
+Ranges Collect(const Common::RangeSet<u64>& set) {
+    Ranges ranges;
+    set.ForEach([&](u64 begin, u64 end) { ranges.emplace_back(begin, end); });
+    return ranges;
+}
+
+/// Builds the joined ranges of an address bitmap, the expected contents of a RangeSet
+template <size_t N>
+Ranges ToRanges(const std::array<bool, N>& bitmap) {
+    Ranges ranges;
+    for (u64 address = 0; address < N; ++address) {
+        if (!bitmap[address]) {
+            continue;
+        }
+        if (!ranges.empty() && ranges.back().second == address) {
+            ++ranges.back().second;
+        } else {
+            ranges.emplace_back(address, address + 1);
+        }
+    }
+    return ranges;
+}
+} // Anonymous namespace
+
+TEST_CASE("RangeSet: Join and split", "[common]") {
+    Common::RangeSet<u64> set;
+    set.Add(100, 50);
+    set.Add(150, 50);
+    set.Add(300, 10);
+    REQUIRE(Collect(set) == Ranges{{100, 200}, {300, 310}});
+
+    set.Add(190, 120);
+    REQUIRE(Collect(set) == Ranges{{100, 310}});
+
+    set.Subtract(150, 10);
+    REQUIRE(Collect(set) == Ranges{{100, 150}, {160, 310}});
+
+    Ranges clipped;
+    set.ForEachInRange(140, 30, [&](u64 begin, u64 end) { clipped.emplace_back(begin, end); });
+    REQUIRE(clipped == Ranges{{140, 150}, {160, 170}});
+
+    set.Add(500, 0);
+    set.Subtract(200, 0);
+    REQUIRE(Collect(set) == Ranges{{100, 150}, {160, 310}});
+
+    set.Subtract(0, 1000);
+    REQUIRE(set.Empty());
+}
+
+TEST_CASE("RangeSet: Random operations match a bitmap", "[common]") {
+    constexpr size_t SIZE = 512;
+    std::mt19937 rng{1234};
+    std::uniform_int_distribution<u64> address_dist{0, SIZE - 1};
+    std::uniform_int_distribution<u64> size_dist{0, 64};
+
+    Common::RangeSet<u64> set;
+    Common::RangeSet<u64> other;
+    std::array<bool, SIZE> expected{};
+    std::array<bool, SIZE> expected_other{};
+    for (int iteration = 0; iteration < 4000; ++iteration) {
+        const u64 address = address_dist(rng);
+        const u64 size = std::min<u64>(size_dist(rng), SIZE - address);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            set.Add(address, size);
+            std::fill_n(expected.begin() + address, size, true);
+            break;
+        case 2:
+            set.Subtract(address, size);
+            std::fill_n(expected.begin() + address, size, false);
+            break;
+        case 3:
+            other.Add(address, size);
+            std::fill_n(expected_other.begin() + address, size, true);
+            if (rng() % 8 == 0) {
+                set.Subtract(other);
+                for (size_t index = 0; index < SIZE; ++index) {
+                    expected[index] = expected[index] && !expected_other[index];
+                }
+                other.Clear();
+                expected_other = {};
+            }
+            break;
+        }
+        REQUIRE(Collect(set) == ToRanges(expected));
+    }
+}
+
+TEST_CASE("OverlapRangeSet: Counts and deletions", "[common]") {
+    using CountedRanges = std::vector<std::array<u64, 3>>;
+    const auto collect{[](const Common::OverlapRangeSet<u64>& set) {
+        CountedRanges ranges;
+        set.ForEach([&](u64 begin, u64 end, s32 count) {
+            ranges.push_back({begin, end, static_cast<u64>(count)});
+        });
+        return ranges;
+    }};
+    Common::OverlapRangeSet<u64> set;
+    set.Add(0, 100);
+    set.Add(50, 100);
+    REQUIRE(collect(set) == CountedRanges{{0, 50, 1}, {50, 100, 2}, {100, 150, 1}});
+
+    Ranges deleted;
+    set.Subtract(25, 100, [&](u64 begin, u64 end) { deleted.emplace_back(begin, end); });
+    REQUIRE(deleted == Ranges{{25, 50}, {100, 125}});
+    REQUIRE(collect(set) == CountedRanges{{0, 25, 1}, {50, 100, 1}, {125, 150, 1}});
+
+    set.Add(50, 100);
+    set.DeleteAll(60, 20);
+    REQUIRE(collect(set) ==
+            CountedRanges{{0, 25, 1}, {50, 60, 2}, {80, 100, 2}, {100, 125, 1}, {125, 150, 2}});
+
+    set.Subtract(0, 200);
+    REQUIRE(collect(set) == CountedRanges{{50, 60, 1}, {80, 100, 1}, {125, 150, 1}});
+
+    std::vector<s32> counts;
+    set.ForEachInRange(55, 30, [&](u64 begin, u64 end, s32 count) { counts.push_back(count); });
+    REQUIRE(counts == std::vector<s32>{1, 1});
+}
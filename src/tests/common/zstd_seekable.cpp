@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/zstd_seekable.h"
+
+using Common::Compression::SeekableZSTDReader;
+using Common::Compression::SeekableZSTDWriter;
+using Common::Compression::ZSTDDictionary;
+
+namespace {
+/// Builds records that share most of their contents, like serialized shader environments
+std::vector<std::vector<u8>> MakeRecords(size_t count) {
+    std::vector<std::vector<u8>> records;
+    for (size_t index = 0; index < count; ++index) {
+        const std::string text = "shader environment " + std::to_string(index * 7919) +
+                                 " texture handles 0x" + std::to_string(index % 13) +
+                                 " local memory size " + std::to_string(index % 5 * 256) +
+                                 " workgroup 32 1 1 shared memory 0 program base 0x10000";
+        records.emplace_back(text.begin(), text.end());
+    }
+    return records;
+}
+
+std::vector<u8> WriteArchive(const std::vector<std::vector<u8>>& records,
+                             const ZSTDDictionary* dictionary = nullptr) {
+    std::vector<u8> archive;
+    SeekableZSTDWriter writer(
+        [&archive](std::span<const u8> data) {
+            archive.insert(archive.end(), data.begin(), data.end());
+            return true;
+        },
+        3, 0, dictionary);
+    for (const auto& record : records) {
+        REQUIRE(writer.Append(record));
+    }
+    REQUIRE(writer.Finish());
+    REQUIRE(!writer.Append(records.front()));
+    return archive;
+}
+} // Anonymous namespace
+
+TEST_CASE("SeekableZSTD: Random access", "[common]") {
+    const auto records = MakeRecords(64);
+    const auto archive = WriteArchive(records);
+
+    SeekableZSTDReader reader(archive);
+    REQUIRE(reader.IsValid());
+    REQUIRE(reader.NumRecords() == records.size());
+    for (size_t index = records.size(); index-- > 0;) {
+        REQUIRE(reader.RecordSize(index) == records[index].size());
+        REQUIRE(reader.Read(index) == records[index]);
+    }
+    std::vector<u8> small_buffer(records[3].size() - 1);
+    REQUIRE(!reader.Read(3, small_buffer));
+    REQUIRE(reader.Read(records.size()).empty());
+}
+
+TEST_CASE("SeekableZSTD: Corrupted archives are rejected", "[common]") {
+    const auto records = MakeRecords(4);
+    auto archive = WriteArchive(records);
+
+    const std::vector<u8> truncated(archive.begin() + 1, archive.end());
+    REQUIRE(!SeekableZSTDReader(truncated).IsValid());
+
+    archive.back() ^= 0xff;
+    REQUIRE(!SeekableZSTDReader(archive).IsValid());
+    REQUIRE(!SeekableZSTDReader(std::span<const u8>{}).IsValid());
+}
+
+TEST_CASE("SeekableZSTD: Dictionaries shrink small records", "[common]") {
+    const auto records = MakeRecords(512);
+    const std::vector<std::span<const u8>> samples(records.begin(), records.end());
+    const ZSTDDictionary dictionary = ZSTDDictionary::Train(samples, 4096);
+    REQUIRE(!dictionary.IsEmpty());
+
+    const auto plain_archive = WriteArchive(records);
+    const auto dictionary_archive = WriteArchive(records, &dictionary);
+    REQUIRE(dictionary_archive.size() < plain_archive.size());
+
+    SeekableZSTDReader reader(dictionary_archive, &dictionary);
+    REQUIRE(reader.IsValid());
+    REQUIRE(reader.Read(100) == records[100]);
+}
+
+TEST_CASE("SeekableZSTD: Mapped files", "[common]") {
+    const auto records = MakeRecords(16);
+    const auto archive = WriteArchive(records);
+    const auto path = std::filesystem::temp_directory_path() / "yuzu_zstd_seekable_test.bin";
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(archive.data()),
+                   static_cast<std::streamsize>(archive.size()));
+    }
+    {
+        SeekableZSTDReader reader(path);
+        REQUIRE(reader.IsValid());
+        REQUIRE(reader.Read(7) == records[7]);
+    }
+    std::filesystem::remove(path);
+    REQUIRE(!SeekableZSTDReader(path).IsValid());
+}
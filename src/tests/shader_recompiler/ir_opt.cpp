@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <initializer_list>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/ir_emitter.h"
+#include "shader_recompiler/frontend/ir/post_order.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/object_pool.h"
+
+using namespace Shader;
+
+namespace {
+/// Builds programs block by block, the syntax list only holds the nodes the passes look at
+class ProgramBuilder {
+public:
+    IR::Block* AddBlock() {
+        IR::Block* const block{block_pool.Create(inst_pool)};
+        program.blocks.push_back(block);
+        return block;
+    }
+
+    void AddBlockNode(IR::Block* block) {
+        auto& node{program.syntax_list.emplace_back()};
+        node.type = IR::AbstractSyntaxNode::Type::Block;
+        node.data.block = block;
+    }
+
+    void AddIfNode(const IR::U1& cond, IR::Block* body, IR::Block* merge) {
+        auto& node{program.syntax_list.emplace_back()};
+        node.type = IR::AbstractSyntaxNode::Type::If;
+        node.data.if_node.cond = cond;
+        node.data.if_node.body = body;
+        node.data.if_node.merge = merge;
+    }
+
+    IR::Inst* AddPhi(IR::Block* block, IR::Type type,
+                     std::initializer_list<std::pair<IR::Block*, IR::Value>> operands) {
+        IR::Inst* const phi{&*block->PrependNewInst(block->begin(), IR::Opcode::Phi)};
+        phi->SetFlags(type);
+        for (const auto& [predecessor, value] : operands) {
+            phi->AddPhiOperand(predecessor, value);
+        }
+        return phi;
+    }
+
+    IR::Program& Finish() {
+        program.post_order_blocks = IR::PostOrder(program.syntax_list.front());
+        return program;
+    }
+
+private:
+    ObjectPool<IR::Inst> inst_pool;
+    ObjectPool<IR::Block> block_pool;
+    IR::Program program;
+};
+
+/// Returns the value stored by the last shared memory write of a block
+IR::Value StoredValue(IR::Block* block) {
+    for (auto it = block->rbegin(); it != block->rend(); ++it) {
+        if (it->GetOpcode() == IR::Opcode::WriteSharedU32) {
+            return it->Arg(1).Resolve();
+        }
+    }
+    FAIL("Block has no shared memory write");
+    return {};
+}
+
+/// Loads an opaque value that no pass can fold or number
+IR::U32 Opaque(IR::IREmitter& ir, u32 offset) {
+    return IR::U32{ir.LoadShared(32, false, ir.Imm32(offset))};
+}
+} // Anonymous namespace
+
+TEST_CASE("SCCP: Constants flow through phis of taken branches", "[shader]") {
+    ProgramBuilder builder;
+    IR::Block* const entry{builder.AddBlock()};
+    IR::Block* const body{builder.AddBlock()};
+    IR::Block* const merge{builder.AddBlock()};
+
+    IR::IREmitter entry_ir{*entry};
+    const IR::U32 sum{entry_ir.IAdd(entry_ir.Imm32(2), entry_ir.Imm32(3))};
+    const IR::U1 cond{entry_ir.IEqual(sum, entry_ir.Imm32(5))};
+    entry->AddBranch(body);
+    entry->AddBranch(merge);
+
+    IR::IREmitter body_ir{*body};
+    const IR::U32 product{body_ir.IMul(sum, body_ir.Imm32(2))};
+    body->AddBranch(merge);
+
+    // The value from the entry block flows through an edge that is never taken
+    IR::Inst* const phi{builder.AddPhi(merge, IR::Type::U32,
+                                       {{entry, IR::Value{7U}}, {body, IR::Value{product}}})};
+    IR::IREmitter merge_ir{*merge};
+    merge_ir.WriteShared(32, merge_ir.Imm32(0), IR::Value{phi});
+
+    builder.AddBlockNode(entry);
+    builder.AddIfNode(cond, body, merge);
+    builder.AddBlockNode(body);
+    builder.AddBlockNode(merge);
+    Optimization::SparseConditionalConstantPropagationPass(builder.Finish());
+
+    const IR::Value stored{StoredValue(merge)};
+    REQUIRE(stored.IsImmediate());
+    REQUIRE(stored.U32() == 10);
+}
+
+TEST_CASE("SCCP: Phis of different constants are not folded", "[shader]") {
+    ProgramBuilder builder;
+    IR::Block* const entry{builder.AddBlock()};
+    IR::Block* const body{builder.AddBlock()};
+    IR::Block* const merge{builder.AddBlock()};
+
+    IR::IREmitter entry_ir{*entry};
+    const IR::U1 cond{entry_ir.IEqual(Opaque(entry_ir, 0), entry_ir.Imm32(5))};
+    entry->AddBranch(body);
+    entry->AddBranch(merge);
+    body->AddBranch(merge);
+
+    IR::Inst* const phi{builder.AddPhi(merge, IR::Type::U32,
+                                       {{entry, IR::Value{7U}}, {body, IR::Value{10U}}})};
+    IR::IREmitter merge_ir{*merge};
+    merge_ir.WriteShared(32, merge_ir.Imm32(0), IR::Value{phi});
+
+    builder.AddBlockNode(entry);
+    builder.AddIfNode(cond, body, merge);
+    builder.AddBlockNode(body);
+    builder.AddBlockNode(merge);
+    Optimization::SparseConditionalConstantPropagationPass(builder.Finish());
+
+    const IR::Value stored{StoredValue(merge)};
+    REQUIRE(!stored.IsImmediate());
+    REQUIRE(stored.Inst() == phi);
+}
+
+TEST_CASE("GVN: Expressions are reused in dominated blocks", "[shader]") {
+    ProgramBuilder builder;
+    IR::Block* const entry{builder.AddBlock()};
+    IR::Block* const next{builder.AddBlock()};
+
+    IR::IREmitter entry_ir{*entry};
+    const IR::U32 lhs{Opaque(entry_ir, 0)};
+    const IR::U32 rhs{Opaque(entry_ir, 4)};
+    const IR::U32 sum{entry_ir.IAdd(lhs, rhs)};
+    entry_ir.WriteShared(32, entry_ir.Imm32(8), sum);
+    entry->AddBranch(next);
+
+    // Operands of commutative operations are matched in either order
+    IR::IREmitter next_ir{*next};
+    next_ir.WriteShared(32, next_ir.Imm32(12), next_ir.IAdd(rhs, lhs));
+
+    builder.AddBlockNode(entry);
+    builder.AddBlockNode(next);
+    Optimization::GlobalValueNumberingPass(builder.Finish());
+
+    const IR::Value stored{StoredValue(next)};
+    REQUIRE(!stored.IsImmediate());
+    REQUIRE(stored.Inst() == sum.Inst());
+}
+
+TEST_CASE("GVN: Expressions are not reused across sibling blocks", "[shader]") {
+    ProgramBuilder builder;
+    IR::Block* const entry{builder.AddBlock()};
+    IR::Block* const then_block{builder.AddBlock()};
+    IR::Block* const else_block{builder.AddBlock()};
+    IR::Block* const merge{builder.AddBlock()};
+
+    IR::IREmitter entry_ir{*entry};
+    const IR::U32 lhs{Opaque(entry_ir, 0)};
+    const IR::U32 rhs{Opaque(entry_ir, 4)};
+    entry->AddBranch(then_block);
+    entry->AddBranch(else_block);
+
+    IR::IREmitter then_ir{*then_block};
+    const IR::U32 then_sum{then_ir.IAdd(lhs, rhs)};
+    then_ir.WriteShared(32, then_ir.Imm32(8), then_sum);
+    then_block->AddBranch(merge);
+
+    IR::IREmitter else_ir{*else_block};
+    const IR::U32 else_sum{else_ir.IAdd(lhs, rhs)};
+    else_ir.WriteShared(32, else_ir.Imm32(8), else_sum);
+    else_block->AddBranch(merge);
+
+    // Neither sibling dominates the merge block, so its sum is kept as well
+    IR::IREmitter merge_ir{*merge};
+    const IR::U32 merge_sum{merge_ir.IAdd(lhs, rhs)};
+    merge_ir.WriteShared(32, merge_ir.Imm32(8), merge_sum);
+
+    builder.AddBlockNode(entry);
+    Optimization::GlobalValueNumberingPass(builder.Finish());
+
+    REQUIRE(StoredValue(then_block).Inst() == then_sum.Inst());
+    REQUIRE(StoredValue(else_block).Inst() == else_sum.Inst());
+    REQUIRE(StoredValue(merge).Inst() == merge_sum.Inst());
+}
+
+TEST_CASE("GVN: Memory reads are not numbered", "[shader]") {
+    ProgramBuilder builder;
+    IR::Block* const entry{builder.AddBlock()};
+
+    IR::IREmitter ir{*entry};
+    const IR::U32 first{Opaque(ir, 0)};
+    ir.WriteShared(32, ir.Imm32(0), ir.Imm32(1));
+    const IR::U32 second{Opaque(ir, 0)};
+    ir.WriteShared(32, ir.Imm32(4), second);
+
+    builder.AddBlockNode(entry);
+    Optimization::GlobalValueNumberingPass(builder.Finish());
+
+    REQUIRE(first.Inst() != second.Inst());
+    REQUIRE(StoredValue(entry).Inst() == second.Inst());
+}
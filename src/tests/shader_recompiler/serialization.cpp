@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "shader_recompiler/backend/glsl/emit_glsl.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/ir_emitter.h"
+#include "shader_recompiler/frontend/ir/post_order.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/frontend/ir/serialization.h"
+#include "shader_recompiler/object_pool.h"
+#include "shader_recompiler/profile.h"
+
+using namespace Shader;
+
+namespace {
+/// Owns the pools of a program built by hand, with an if statement that merges through a phi
+class TestProgram {
+public:
+    TestProgram() {
+        IR::Block* const entry{AddBlock()};
+        IR::Block* const body{AddBlock()};
+        IR::Block* const merge{AddBlock()};
+
+        IR::IREmitter entry_ir{*entry};
+        const IR::U32 lhs{entry_ir.LoadShared(32, false, entry_ir.Imm32(0))};
+        const IR::U32 rhs{entry_ir.LoadShared(32, false, entry_ir.Imm32(4))};
+        const IR::U32 sum{entry_ir.IAdd(lhs, rhs)};
+        // Pseudo-operations are rebuilt from their arguments, make sure they stay attached
+        const IR::U1 cond{entry_ir.ConditionRef(
+            entry_ir.LogicalOr(entry_ir.GetCarryFromOp(sum), entry_ir.GetZeroFromOp(sum)))};
+        entry->AddBranch(body);
+        entry->AddBranch(merge);
+
+        IR::IREmitter body_ir{*body};
+        const IR::U32 product{body_ir.IMul(sum, body_ir.Imm32(3))};
+        body->AddBranch(merge);
+
+        IR::Inst* const phi{&*merge->PrependNewInst(merge->begin(), IR::Opcode::Phi)};
+        phi->SetFlags(IR::Type::U32);
+        phi->AddPhiOperand(entry, sum);
+        phi->AddPhiOperand(body, product);
+        IR::IREmitter merge_ir{*merge};
+        merge_ir.WriteShared(32, merge_ir.Imm32(8), IR::Value{phi});
+
+        AddNode(IR::AbstractSyntaxNode::Type::Block).data.block = entry;
+        auto& if_node{AddNode(IR::AbstractSyntaxNode::Type::If).data.if_node};
+        if_node.cond = cond;
+        if_node.body = body;
+        if_node.merge = merge;
+        AddNode(IR::AbstractSyntaxNode::Type::Block).data.block = body;
+        AddNode(IR::AbstractSyntaxNode::Type::EndIf).data.end_if.merge = merge;
+        AddNode(IR::AbstractSyntaxNode::Type::Block).data.block = merge;
+        AddNode(IR::AbstractSyntaxNode::Type::Return);
+
+        program.post_order_blocks = IR::PostOrder(program.syntax_list.front());
+        program.stage = Stage::Compute;
+        program.workgroup_size = {1, 1, 1};
+        program.shared_memory_size = 12;
+    }
+
+    ObjectPool<IR::Inst> inst_pool;
+    ObjectPool<IR::Block> block_pool;
+    IR::Program program;
+
+private:
+    IR::Block* AddBlock() {
+        IR::Block* const block{block_pool.Create(inst_pool)};
+        program.blocks.push_back(block);
+        return block;
+    }
+
+    IR::AbstractSyntaxNode& AddNode(IR::AbstractSyntaxNode::Type type) {
+        auto& node{program.syntax_list.emplace_back()};
+        node.type = type;
+        return node;
+    }
+};
+
+std::optional<IR::Program> Deserialize(TestProgram& owner, const std::vector<u8>& data) {
+    return IR::DeserializeProgram(owner.inst_pool, owner.block_pool, data);
+}
+} // Anonymous namespace
+
+TEST_CASE("IR serialization: Round trip emits the same code", "[shader]") {
+    TestProgram original;
+    const std::vector<u8> data{IR::SerializeProgram(original.program)};
+    REQUIRE(!data.empty());
+
+    TestProgram restored_owner;
+    std::optional<IR::Program> restored{Deserialize(restored_owner, data)};
+    REQUIRE(restored.has_value());
+    REQUIRE(restored->blocks.size() == original.program.blocks.size());
+    REQUIRE(restored->syntax_list.size() == original.program.syntax_list.size());
+    REQUIRE(IR::SerializeProgram(*restored) == data);
+
+    // Emission rewrites the program, so it is only done once both sides have been serialized
+    const Profile profile{};
+    const std::string expected{Backend::GLSL::EmitGLSL(profile, original.program)};
+    const std::string actual{Backend::GLSL::EmitGLSL(profile, *restored)};
+    REQUIRE(!expected.empty());
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("IR serialization: Truncated data is rejected", "[shader]") {
+    TestProgram original;
+    const std::vector<u8> data{IR::SerializeProgram(original.program)};
+    REQUIRE(!data.empty());
+
+    TestProgram restored_owner;
+    for (size_t size = 0; size < data.size(); ++size) {
+        const std::vector<u8> truncated(data.begin(), data.begin() + size);
+        REQUIRE(!Deserialize(restored_owner, truncated).has_value());
+    }
+    std::vector<u8> trailing{data};
+    trailing.push_back(0);
+    REQUIRE(!Deserialize(restored_owner, trailing).has_value());
+}
+
+TEST_CASE("IR serialization: Corrupt headers are rejected", "[shader]") {
+    TestProgram original;
+    const std::vector<u8> data{IR::SerializeProgram(original.program)};
+    REQUIRE(data.size() > 12);
+
+    TestProgram restored_owner;
+    // The header holds the format version, the number of opcodes and the number of blocks
+    for (const size_t offset : {0U, 4U, 8U}) {
+        std::vector<u8> corrupt{data};
+        corrupt[offset + 3] ^= 0x80;
+        REQUIRE(!Deserialize(restored_owner, corrupt).has_value());
+    }
+}
@@ -0,0 +1,518 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Translates every pipeline stored in a directory of pipeline cache files through the shader
+// recompiler, reporting the host time spent in each pass and backend and the size of the generated
+// IR and code. The hashes of the generated IR and code can be written and later compared to flag
+// semantic changes.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "common/container_hash.h"
+#include "common/logging/backend.h"
+#include "shader_recompiler/backend/bindings.h"
+#include "shader_recompiler/backend/glasm/emit_glasm.h"
+#include "shader_recompiler/backend/glsl/emit_glsl.h"
+#include "shader_recompiler/backend/spirv/emit_spirv.h"
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/frontend/ir/serialization.h"
+#include "shader_recompiler/frontend/maxwell/control_flow.h"
+#include "shader_recompiler/frontend/maxwell/translate_program.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/object_pool.h"
+#include "shader_recompiler/pass_timings.h"
+#include "shader_recompiler/profile.h"
+#include "shader_recompiler/program_header.h"
+#include "shader_recompiler/runtime_info.h"
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+#include "video_core/shader_environment.h"
+#include "video_core/transform_feedback.h"
+
+namespace {
+
+using VideoCommon::FileEnvironment;
+
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+
+// Layouts of the backend pipeline keys stored after the environments of each pipeline.
+// These have to match GraphicsPipelineCacheKey/ComputePipelineCacheKey in the Vulkan backend and
+// GraphicsPipelineKey/ComputePipelineKey in the OpenGL backend.
+struct ComputeKey {
+    u64 unique_hash;
+    u32 shared_memory_size;
+    std::array<u32, 3> workgroup_size;
+};
+
+struct VulkanGraphicsKey {
+    std::array<u64, 6> unique_hashes;
+    Vulkan::FixedPipelineState state;
+};
+
+struct OpenGLGraphicsKey {
+    std::array<u64, 6> unique_hashes;
+    u32 raw;
+    std::array<u32, 3> padding;
+    VideoCommon::TransformFeedbackState xfb_state;
+};
+
+enum class Backend {
+    SPIRV,
+    GLSL,
+    GLASM,
+};
+constexpr std::array BACKENDS{Backend::SPIRV, Backend::GLSL, Backend::GLASM};
+
+struct Pipeline {
+    std::string name;
+    std::vector<FileEnvironment> envs;
+};
+
+struct PipelineHashes {
+    u64 ir{};
+    std::array<u64, BACKENDS.size()> code{};
+};
+
+struct TranslateResult {
+    u64 ir_hash{};
+    u64 code_hash{};
+    size_t num_insts{}; ///< Number of IR instructions after optimization
+    size_t code_size{}; ///< Size of the generated code in bytes
+};
+
+/// Accumulated size of the IR and code generated for the whole corpus
+struct CorpusSizes {
+    size_t num_insts{};
+    std::array<size_t, BACKENDS.size()> code{};
+};
+
+struct Pools {
+    void ReleaseContents() {
+        flow_block.ReleaseContents();
+        block.ReleaseContents();
+        inst.ReleaseContents();
+    }
+
+    Shader::ObjectPool<Shader::IR::Inst> inst{8192};
+    Shader::ObjectPool<Shader::IR::Block> block{32};
+    Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+};
+
+std::string_view BackendName(Backend backend) {
+    switch (backend) {
+    case Backend::SPIRV:
+        return "EmitSPIRV";
+    case Backend::GLSL:
+        return "EmitGLSL";
+    case Backend::GLASM:
+        return "EmitGLASM";
+    }
+    return "Unknown";
+}
+
+Shader::Profile MakeProfile() {
+    // Capabilities of a typical desktop driver, so every backend path is exercised
+    return Shader::Profile{
+        .supported_spirv = 0x00010600,
+        .unified_descriptor_binding = true,
+        .support_descriptor_aliasing = true,
+        .support_int8 = true,
+        .support_int16 = true,
+        .support_int64 = true,
+        .support_vertex_instance_id = false,
+        .support_float_controls = true,
+        .support_separate_denorm_behavior = true,
+        .support_separate_rounding_mode = true,
+        .support_fp16_denorm_preserve = true,
+        .support_fp32_denorm_preserve = true,
+        .support_fp16_denorm_flush = true,
+        .support_fp32_denorm_flush = true,
+        .support_fp16_signed_zero_nan_preserve = true,
+        .support_fp32_signed_zero_nan_preserve = true,
+        .support_fp64_signed_zero_nan_preserve = true,
+        .support_explicit_workgroup_layout = true,
+        .support_vote = true,
+        .support_viewport_index_layer_non_geometry = true,
+        .support_viewport_mask = true,
+        .support_typeless_image_loads = true,
+        .support_demote_to_helper_invocation = true,
+        .support_int64_atomics = true,
+        .support_derivative_control = true,
+        .support_geometry_shader_passthrough = true,
+        .support_native_ndc = true,
+        .support_gl_nv_gpu_shader_5 = true,
+        .support_gl_amd_gpu_shader_half_float = false,
+        .support_gl_texture_shadow_lod = true,
+        .support_gl_warp_intrinsics = true,
+        .support_gl_variable_aoffi = true,
+        .support_gl_sparse_textures = true,
+        .support_gl_derivative_control = true,
+        .support_scaled_attributes = true,
+        .support_multi_viewport = true,
+        .support_geometry_streams = true,
+        .gl_max_compute_smem_size = 0xc000,
+        .min_ssbo_alignment = 16,
+        .max_user_clip_distances = 8,
+    };
+}
+
+Shader::HostTranslateInfo MakeHostInfo(bool enable_global_optimizations) {
+    return Shader::HostTranslateInfo{
+        .support_float64 = true,
+        .support_float16 = true,
+        .support_int64 = true,
+        .needs_demote_reorder = false,
+        .support_snorm_render_buffer = true,
+        .support_viewport_index_layer = true,
+        .min_ssbo_alignment = 16,
+        .support_geometry_shader_passthrough = true,
+        .support_conditional_barrier = true,
+        .enable_global_optimizations = enable_global_optimizations,
+    };
+}
+
+bool ReadPipelineCache(const std::filesystem::path& path, const std::filesystem::path& directory,
+                       size_t compute_key_size, size_t graphics_key_size,
+                       std::vector<Pipeline>& pipelines) try {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{file.tellg()};
+    file.seekg(0, std::ios::beg);
+
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
+    if (magic_number != MAGIC_NUMBER) {
+        fmt::print(stderr, "{}: invalid pipeline cache file\n", path.string());
+        return false;
+    }
+    const std::string relative_path{std::filesystem::relative(path, directory).generic_string()};
+    size_t index{};
+    while (file.tellg() != end) {
+        u32 num_envs{};
+        file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+        Pipeline pipeline{
+            .name = fmt::format("{}:{}", relative_path, index++),
+            .envs = std::vector<FileEnvironment>(num_envs),
+        };
+        for (FileEnvironment& env : pipeline.envs) {
+            env.Deserialize(file);
+        }
+        const bool is_compute{pipeline.envs.front().ShaderStage() == Shader::Stage::Compute};
+        file.seekg(is_compute ? compute_key_size : graphics_key_size, std::ios::cur);
+        pipelines.push_back(std::move(pipeline));
+    }
+    return true;
+
+} catch (const std::ios_base::failure& e) {
+    fmt::print(stderr, "{}: {}\n", path.string(), e.what());
+    return false;
+}
+
+std::vector<Pipeline> LoadCorpus(const std::filesystem::path& directory) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    // Keep pipeline names stable between runs
+    std::ranges::sort(files);
+
+    std::vector<Pipeline> pipelines;
+    for (const auto& path : files) {
+        const auto filename{path.filename()};
+        if (filename == "vulkan.bin") {
+            ReadPipelineCache(path, directory, sizeof(ComputeKey), sizeof(VulkanGraphicsKey),
+                              pipelines);
+        } else if (filename == "opengl.bin") {
+            ReadPipelineCache(path, directory, sizeof(ComputeKey), sizeof(OpenGLGraphicsKey),
+                              pipelines);
+        }
+    }
+    return pipelines;
+}
+
+/// Translates and emits a pipeline for a backend, returning the hashes and sizes of the IR and code
+/// When round_trip_ir is set, programs go through the shader IR cache format before being finalized
+/// Frontend passes are only timed when time_frontend is set, the backend is always timed
+TranslateResult TranslatePipeline(Pipeline& pipeline, Backend backend,
+                                  const Shader::HostTranslateInfo& host_info, bool round_trip_ir,
+                                  bool time_frontend, Pools& pools, Shader::PassTimings& timings) {
+    static const Shader::Profile profile{MakeProfile()};
+    Shader::PassTimings* const frontend_timings{time_frontend ? &timings : nullptr};
+
+    pools.ReleaseContents();
+
+    std::vector<Shader::IR::Program> programs;
+    programs.reserve(pipeline.envs.size());
+    std::optional<Shader::IR::Program> vertex_a;
+    for (FileEnvironment& env : pipeline.envs) {
+        const bool is_compute{env.ShaderStage() == Shader::Stage::Compute};
+        const bool is_vertex_a{env.ShaderStage() == Shader::Stage::VertexA};
+        const u32 cfg_offset{static_cast<u32>(
+            env.StartAddress() + (is_compute ? 0 : sizeof(Shader::ProgramHeader)))};
+        std::optional<Shader::Maxwell::Flow::CFG> cfg;
+        Shader::RunPass(frontend_timings, "CFG",
+                        [&] { cfg.emplace(env, pools.flow_block, cfg_offset, is_vertex_a); });
+
+        auto program{Shader::Maxwell::TranslateProgramBase(pools.inst, pools.block, env, *cfg,
+                                                           host_info, frontend_timings)};
+        if (round_trip_ir) {
+            std::vector<u8> data;
+            std::optional<Shader::IR::Program> restored;
+            Shader::RunPass(frontend_timings, "SerializeProgram",
+                            [&] { data = Shader::IR::SerializeProgram(program); });
+            Shader::RunPass(frontend_timings, "DeserializeProgram", [&] {
+                restored = Shader::IR::DeserializeProgram(pools.inst, pools.block, data);
+            });
+            if (!restored) {
+                throw Shader::LogicError("Program failed to round-trip the IR cache format");
+            }
+            program = std::move(*restored);
+        }
+        Shader::Maxwell::FinalizeProgram(env, program, host_info, frontend_timings);
+        if (is_vertex_a) {
+            vertex_a = std::move(program);
+            continue;
+        }
+        if (vertex_a && env.ShaderStage() == Shader::Stage::VertexB) {
+            program = Shader::Maxwell::MergeDualVertexPrograms(*vertex_a, program, env);
+            vertex_a.reset();
+        }
+        programs.push_back(std::move(program));
+    }
+
+    size_t ir_hash{};
+    TranslateResult result;
+    for (const Shader::IR::Program& program : programs) {
+        const std::string dump{Shader::IR::DumpProgram(program)};
+        Common::HashCombine(ir_hash, Common::CityHash64(dump.data(), dump.size()));
+        for (const Shader::IR::Block* const block : program.blocks) {
+            result.num_insts += block->Instructions().size();
+        }
+    }
+
+    size_t code_hash{};
+    Shader::Backend::Bindings bindings;
+    const Shader::IR::Program* previous_program{};
+    for (Shader::IR::Program& program : programs) {
+        Shader::RuntimeInfo runtime_info{};
+        runtime_info.glasm_use_storage_buffers = true;
+        if (previous_program) {
+            runtime_info.previous_stage_stores = previous_program->info.stores;
+            runtime_info.previous_stage_legacy_stores_mapping =
+                previous_program->info.legacy_stores_mapping;
+        }
+        Shader::Maxwell::ConvertLegacyToGeneric(program, runtime_info);
+
+        timings.Measure(BackendName(backend), [&] {
+            switch (backend) {
+            case Backend::SPIRV: {
+                const auto code{Shader::Backend::SPIRV::EmitSPIRV(profile, runtime_info, program,
+                                                                 bindings)};
+                Common::HashCombine(code_hash,
+                                    Common::CityHash64(reinterpret_cast<const char*>(code.data()),
+                                                       code.size() * sizeof(u32)));
+                result.code_size += code.size() * sizeof(u32);
+                break;
+            }
+            case Backend::GLSL: {
+                const auto code{
+                    Shader::Backend::GLSL::EmitGLSL(profile, runtime_info, program, bindings)};
+                Common::HashCombine(code_hash, Common::CityHash64(code.data(), code.size()));
+                result.code_size += code.size();
+                break;
+            }
+            case Backend::GLASM: {
+                const auto code{
+                    Shader::Backend::GLASM::EmitGLASM(profile, runtime_info, program, bindings)};
+                Common::HashCombine(code_hash, Common::CityHash64(code.data(), code.size()));
+                result.code_size += code.size();
+                break;
+            }
+            }
+        });
+        previous_program = &program;
+    }
+    result.ir_hash = ir_hash;
+    result.code_hash = code_hash;
+    return result;
+}
+
+std::map<std::string, std::string> ReadHashes(const std::filesystem::path& path) {
+    std::map<std::string, std::string> hashes;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t separator{line.find(' ')};
+        if (separator != std::string::npos) {
+            hashes.emplace(line.substr(0, separator), line.substr(separator + 1));
+        }
+    }
+    return hashes;
+}
+
+void PrintUsage(const char* argv0) {
+    fmt::print(stderr,
+               "Usage: {} [options] <corpus directory>\n"
+               "  --iterations <n>  Number of times the corpus is translated\n"
+               "  --global-opts     Run the SCCP and value numbering passes\n"
+               "  --ir-cache        Round-trip programs through the shader IR cache format\n"
+               "  --write <file>    Write the hashes of the generated IR and code\n"
+               "  --expect <file>   Compare the generated IR and code against stored hashes\n",
+               argv0);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Common::Log::DisableLoggingInTests();
+
+    std::optional<std::filesystem::path> corpus_dir;
+    std::optional<std::filesystem::path> write_path;
+    std::optional<std::filesystem::path> expect_path;
+    int iterations{1};
+    bool global_optimizations{};
+    bool round_trip_ir{};
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        const bool has_value{i + 1 < argc};
+        if (arg == "--iterations" && has_value) {
+            iterations = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--global-opts") {
+            global_optimizations = true;
+        } else if (arg == "--ir-cache") {
+            round_trip_ir = true;
+        } else if (arg == "--write" && has_value) {
+            write_path = argv[++i];
+        } else if (arg == "--expect" && has_value) {
+            expect_path = argv[++i];
+        } else if (!arg.starts_with("--") && !corpus_dir) {
+            corpus_dir = arg;
+        } else {
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (!corpus_dir) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Pipeline> pipelines{LoadCorpus(*corpus_dir)};
+    if (pipelines.empty()) {
+        fmt::print(stderr, "No pipelines found in {}\n", corpus_dir->string());
+        return EXIT_FAILURE;
+    }
+
+    const Shader::HostTranslateInfo host_info{MakeHostInfo(global_optimizations)};
+    Pools pools;
+    Shader::PassTimings timings;
+    CorpusSizes sizes;
+    std::vector<std::optional<PipelineHashes>> hashes(pipelines.size());
+    size_t num_shaders{};
+    size_t num_failures{};
+    const auto start{std::chrono::steady_clock::now()};
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        for (size_t index = 0; index < pipelines.size(); ++index) {
+            Pipeline& pipeline{pipelines[index]};
+            PipelineHashes result;
+            bool failed{};
+            for (size_t backend = 0; backend < BACKENDS.size(); ++backend) {
+                try {
+                    // Emission consumes the IR, so each backend translates the pipeline again.
+                    // The frontend work is the same every time, only the first one is timed.
+                    const TranslateResult translated{
+                        TranslatePipeline(pipeline, BACKENDS[backend], host_info, round_trip_ir,
+                                          backend == 0, pools, timings)};
+                    result.ir = translated.ir_hash;
+                    result.code[backend] = translated.code_hash;
+                    if (iteration == 0) {
+                        // The IR is the same for every backend, count it once
+                        sizes.num_insts += backend == 0 ? translated.num_insts : 0;
+                        sizes.code[backend] += translated.code_size;
+                    }
+                } catch (const Shader::Exception& exception) {
+                    if (iteration == 0) {
+                        fmt::print(stderr, "{} {}: {}\n", pipeline.name,
+                                   BackendName(BACKENDS[backend]), exception.what());
+                    }
+                    failed = true;
+                }
+            }
+            if (iteration == 0) {
+                num_shaders += pipeline.envs.size();
+                num_failures += failed ? 1 : 0;
+                hashes[index] = result;
+            }
+        }
+    }
+    const auto total_time{std::chrono::steady_clock::now() - start};
+
+    fmt::print("{} pipelines, {} shaders, {} failures, {} iterations, {:.3f} ms total\n",
+               pipelines.size(), num_shaders, num_failures, iterations,
+               std::chrono::duration<double, std::milli>(total_time).count());
+    fmt::print("{:<36} {:>12} {:>14}\n", "Pass", "Total ms", "us/iteration");
+    for (const auto& entry : timings.Entries()) {
+        const double total_ms{std::chrono::duration<double, std::milli>(entry.time).count()};
+        fmt::print("{:<36} {:>12.3f} {:>14.1f}\n", entry.name, total_ms,
+                   total_ms * 1000.0 / iterations);
+    }
+    fmt::print("{:<36} {:>12}\n", "Output", "Size");
+    fmt::print("{:<36} {:>12}\n", "IR instructions", sizes.num_insts);
+    for (size_t backend = 0; backend < BACKENDS.size(); ++backend) {
+        fmt::print("{:<36} {:>12}\n", fmt::format("{} bytes", BackendName(BACKENDS[backend])),
+                   sizes.code[backend]);
+    }
+
+    const auto format_hashes{[](const PipelineHashes& value) {
+        return fmt::format("{:016x} {:016x} {:016x} {:016x}", value.ir, value.code[0],
+                           value.code[1], value.code[2]);
+    }};
+    if (write_path) {
+        std::ofstream file(*write_path);
+        for (size_t index = 0; index < pipelines.size(); ++index) {
+            file << pipelines[index].name << ' ' << format_hashes(*hashes[index]) << '\n';
+        }
+    }
+    if (expect_path) {
+        const auto expected{ReadHashes(*expect_path)};
+        size_t num_mismatches{};
+        for (size_t index = 0; index < pipelines.size(); ++index) {
+            const std::string& name{pipelines[index].name};
+            const std::string actual{format_hashes(*hashes[index])};
+            const auto it{expected.find(name)};
+            if (it == expected.end()) {
+                fmt::print("New pipeline {}\n", name);
+            } else if (it->second != actual) {
+                fmt::print("Mismatch in {}: expected {}, got {}\n", name, it->second, actual);
+                ++num_mismatches;
+            }
+        }
+        if (num_mismatches != 0) {
+            fmt::print("{} pipelines changed\n", num_mismatches);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
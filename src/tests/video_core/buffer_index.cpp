@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/buffer_cache/buffer_index.h"
+
+namespace {
+constexpr u64 PAGE = 0x10000;
+} // Anonymous namespace
+
+using BufferIndex = VideoCommon::BufferIndex<u32>;
+
+TEST_CASE("BufferIndex: Find", "[video_core]") {
+    BufferIndex index;
+    index.Insert(PAGE * 2, PAGE * 4, 1);
+    index.Insert(PAGE * 6, PAGE * 7, 2);
+    REQUIRE(index.Size() == 2);
+
+    REQUIRE(!index.Find(PAGE));
+    REQUIRE(index.Find(PAGE * 2)->id == 1);
+    REQUIRE(index.Find(PAGE * 4 - 1)->id == 1);
+    REQUIRE(!index.Find(PAGE * 4));
+    REQUIRE(index.Find(PAGE * 6)->id == 2);
+    REQUIRE(!index.Find(PAGE * 7));
+}
+
+TEST_CASE("BufferIndex: Overlaps", "[video_core]") {
+    BufferIndex index;
+    index.Insert(PAGE * 2, PAGE * 4, 1);
+    index.Insert(PAGE * 6, PAGE * 7, 2);
+    index.Insert(PAGE * 9, PAGE * 12, 3);
+
+    REQUIRE(!index.FindFirstOverlap(0, PAGE * 2));
+    REQUIRE(index.FindFirstOverlap(PAGE * 3, PAGE * 10)->id == 1);
+    REQUIRE(index.FindFirstOverlap(PAGE * 4, PAGE * 10)->id == 2);
+    REQUIRE(!index.FindFirstOverlap(PAGE * 7, PAGE * 9));
+
+    std::vector<u32> ids;
+    index.ForEachOverlap(PAGE * 3, PAGE * 9 + 1, [&](const auto& range) {
+        ids.push_back(range.id);
+    });
+    REQUIRE(ids == std::vector<u32>{1, 2, 3});
+}
+
+TEST_CASE("BufferIndex: Neighbours", "[video_core]") {
+    BufferIndex index;
+    index.Insert(PAGE * 2, PAGE * 4, 1);
+    index.Insert(PAGE * 6, PAGE * 7, 2);
+
+    REQUIRE(index.FindNext(PAGE * 4)->id == 2);
+    REQUIRE(index.FindNext(PAGE * 3)->id == 2);
+    REQUIRE(!index.FindNext(PAGE * 7));
+    REQUIRE(index.FindPrevious(PAGE * 6)->id == 1);
+    REQUIRE(index.FindPrevious(PAGE * 8)->id == 2);
+    REQUIRE(!index.FindPrevious(PAGE * 3));
+}
+
+TEST_CASE("BufferIndex: Erase", "[video_core]") {
+    BufferIndex index;
+    index.Insert(0, PAGE, 1);
+    index.Insert(PAGE / 2, PAGE, 2);
+    index.Erase(PAGE, 1);
+    REQUIRE(index.Find(PAGE / 2)->id == 2);
+    index.Erase(PAGE, 2);
+    REQUIRE(index.Size() == 0);
+    REQUIRE(!index.Find(PAGE / 2));
+}
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/operation_ring.h"
+
+using VideoCommon::OperationRing;
+using VideoCommon::PendingFenceRing;
+
+namespace {
+std::atomic<size_t> num_allocations;
+
+/// Allocator counting how many times ring storage is allocated
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        num_allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* pointer, size_t n) noexcept {
+        std::allocator<T>{}.deallocate(pointer, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept {
+        return true;
+    }
+};
+
+struct StressOperation {
+    u32 producer;
+    u32 index;
+    std::function<void()> callback;
+};
+} // Anonymous namespace
+
+TEST_CASE("OperationRing: FIFO order across wraparound and growth", "[video_core]") {
+    OperationRing<u32> ring;
+    u32 next_push = 0;
+    u32 next_pop = 0;
+    for (u32 round = 0; round < 64; ++round) {
+        // Push more than is popped so the ring wraps around and grows with a non-zero head
+        for (u32 i = 0; i < round % 7 + 3; ++i) {
+            ring.Push(u32{next_push++});
+        }
+        for (u32 i = 0; i < round % 5 + 1 && !ring.Empty(); ++i) {
+            REQUIRE(ring.Front() == next_pop);
+            REQUIRE(ring.PopFront() == next_pop++);
+        }
+    }
+    REQUIRE(ring.Size() == next_push - next_pop);
+    while (!ring.Empty()) {
+        REQUIRE(ring.PopFront() == next_pop++);
+    }
+    REQUIRE(next_pop == next_push);
+}
+
+TEST_CASE("OperationRing: Steady stream doesn't grow storage", "[video_core]") {
+    OperationRing<std::function<void()>> ring;
+    u64 executed = 0;
+    for (u32 i = 0; i < 12; ++i) {
+        ring.Push([&executed] { ++executed; });
+    }
+    const size_t capacity = ring.Capacity();
+    for (u32 i = 0; i < 1'000'000; ++i) {
+        ring.Push([&executed] { ++executed; });
+        ring.PopFront()();
+    }
+    REQUIRE(ring.Capacity() == capacity);
+    REQUIRE(ring.Size() == 12);
+    REQUIRE(executed == 1'000'000);
+}
+
+TEST_CASE("OperationRing: Popped objects are released", "[video_core]") {
+    OperationRing<std::shared_ptr<u32>> ring;
+    auto object = std::make_shared<u32>(7);
+    ring.Push(std::shared_ptr<u32>{object});
+    REQUIRE(object.use_count() == 2);
+    REQUIRE(*ring.PopFront() == 7);
+    REQUIRE(object.use_count() == 1);
+}
+
+TEST_CASE("PendingFenceRing: Concurrent producers release fences in order", "[video_core]") {
+    static constexpr u32 NUM_PRODUCERS = 4;
+    static constexpr u32 FENCES_PER_PRODUCER = 10'000;
+    static constexpr size_t MAX_PENDING_FENCES = 64;
+
+    PendingFenceRing<u64, StressOperation, CountingAllocator<StressOperation>> ring;
+    std::mutex guard;
+    std::condition_variable producer_cv;
+    std::condition_variable release_cv;
+    size_t num_pending = 0;
+    u32 num_producers_done = 0;
+
+    num_allocations = 0;
+    std::atomic<u64> num_executed{};
+    std::array<u32, NUM_PRODUCERS> next_index{};
+    bool in_order = true;
+    u64 last_sequence = 0;
+
+    // Signals fences like FenceManager::SignalFenceImpl, releasing a few operations each
+    const auto produce = [&](u32 producer) {
+        std::vector<StressOperation> operations;
+        u32 index = 0;
+        for (u32 fence = 0; fence < FENCES_PER_PRODUCER; ++fence) {
+            for (u32 i = 0; i < fence % 3; ++i) {
+                operations.push_back(StressOperation{
+                    .producer = producer,
+                    .index = index++,
+                    .callback = [&num_executed] { ++num_executed; },
+                });
+            }
+            std::unique_lock lock{guard};
+            producer_cv.wait(lock, [&] { return num_pending < MAX_PENDING_FENCES; });
+            ring.Push(u64{producer}, operations);
+            operations.clear();
+            ++num_pending;
+            release_cv.notify_one();
+        }
+        std::scoped_lock lock{guard};
+        ++num_producers_done;
+        release_cv.notify_one();
+    };
+
+    // Takes every queued fence at once like FenceManager::ReleaseThreadFunc
+    std::thread release_thread([&] {
+        std::vector<u64> sequences;
+        std::vector<StressOperation> operations;
+        while (true) {
+            {
+                std::unique_lock lock{guard};
+                release_cv.wait(lock, [&] {
+                    return !ring.Empty() || num_producers_done == NUM_PRODUCERS;
+                });
+                if (ring.Empty()) {
+                    return;
+                }
+                while (!ring.Empty()) {
+                    const auto released = ring.PopFront([&](StressOperation&& operation) {
+                        operations.push_back(std::move(operation));
+                    });
+                    sequences.push_back(released.sequence);
+                    --num_pending;
+                }
+                producer_cv.notify_all();
+            }
+            for (const u64 sequence : sequences) {
+                in_order &= sequence == last_sequence + 1;
+                last_sequence = sequence;
+            }
+            for (StressOperation& operation : operations) {
+                in_order &= operation.index == next_index[operation.producer]++;
+                operation.callback();
+            }
+            sequences.clear();
+            operations.clear();
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (u32 producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        producers.emplace_back(produce, producer);
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    release_thread.join();
+
+    u64 expected_operations = 0;
+    for (u32 fence = 0; fence < FENCES_PER_PRODUCER; ++fence) {
+        expected_operations += fence % 3;
+    }
+    REQUIRE(in_order);
+    REQUIRE(last_sequence == NUM_PRODUCERS * FENCES_PER_PRODUCER);
+    REQUIRE(num_executed == expected_operations * NUM_PRODUCERS);
+    for (const u32 index : next_index) {
+        REQUIRE(index == expected_operations);
+    }
+    // Rings only grow until they fit the bounded number of pending fences, from 16 to 64 fences
+    // and from 16 to 128 operations, instead of allocating for every fence
+    REQUIRE(num_allocations <= 7);
+}
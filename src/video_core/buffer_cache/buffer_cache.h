@@ -7,6 +7,7 @@
 #include <memory>
 #include <numeric>
 
+#include "common/cityhash.h"
 #include "common/range_sets.inc"
 #include "video_core/buffer_cache/buffer_cache_base.h"
 #include "video_core/guest_memory.h"
@@ -104,6 +105,26 @@ void BufferCache<P>::TickFrame() {
         runtime.FreeDeferredStagingBuffer(buffer);
     }
     async_buffers_death_ring.clear();
+
+    if (draw_statistics.num_draws != 0) {
+        LOG_DEBUG(HW_GPU,
+                  "Buffer cache: {} draws, {} us per draw, {} uniform buffers inlined, {} "
+                  "streamed, {} bound from cached buffers",
+                  draw_statistics.num_draws,
+                  static_cast<double>(draw_statistics.cpu_time.count()) /
+                      (1000.0 * static_cast<double>(draw_statistics.num_draws)),
+                  draw_statistics.inline_uniform_buffers, draw_statistics.streamed_uniform_buffers,
+                  draw_statistics.cached_uniform_buffers);
+    }
+    draw_statistics = {};
+    time_draws = Settings::values.extended_logging.GetValue();
+
+    if (join_statistics.num_joins != 0) {
+        LOG_DEBUG(HW_GPU, "Buffer cache: {} buffers joined, {} bytes copied, {} bytes reserved",
+                  join_statistics.num_joins, join_statistics.bytes_copied,
+                  join_statistics.bytes_reserved);
+    }
+    join_statistics = {};
 }
 
 template <class P>
@@ -332,6 +353,11 @@ void BufferCache<P>::DisableGraphicsUniformBuffer(size_t stage, u32 index) {
 template <class P>
 void BufferCache<P>::UpdateGraphicsBuffers(bool is_indexed) {
     MICROPROFILE_SCOPE(GPU_PrepareBuffers);
+    const auto start_time = StartDrawTimer();
+    SCOPE_EXIT {
+        StopDrawTimer(start_time);
+    };
+    ++draw_statistics.num_draws;
     do {
         channel_state->has_deleted_buffers = false;
         DoUpdateGraphicsBuffers(is_indexed);
@@ -350,6 +376,10 @@ void BufferCache<P>::UpdateComputeBuffers() {
 template <class P>
 void BufferCache<P>::BindHostGeometryBuffers(bool is_indexed) {
     MICROPROFILE_SCOPE(GPU_BindUploadBuffers);
+    const auto start_time = StartDrawTimer();
+    SCOPE_EXIT {
+        StopDrawTimer(start_time);
+    };
     if (is_indexed) {
         BindHostIndexBuffer();
     } else if constexpr (!HAS_FULL_INDEX_AND_PRIMITIVE_SUPPORT) {
@@ -370,6 +400,10 @@ void BufferCache<P>::BindHostGeometryBuffers(bool is_indexed) {
 template <class P>
 void BufferCache<P>::BindHostStageBuffers(size_t stage) {
     MICROPROFILE_SCOPE(GPU_BindUploadBuffers);
+    const auto start_time = StartDrawTimer();
+    SCOPE_EXIT {
+        StopDrawTimer(start_time);
+    };
     BindHostGraphicsUniformBuffers(stage);
     BindHostGraphicsStorageBuffers(stage);
     BindHostGraphicsTextureBuffers(stage);
@@ -511,6 +545,11 @@ void BufferCache<P>::AccumulateFlushes() {
         return;
     }
     committed_gpu_modified_ranges.emplace_back(std::move(uncommitted_gpu_modified_ranges));
+    if (!spare_gpu_modified_ranges.empty()) {
+        // Reuse the storage of a set released by a previous flush
+        uncommitted_gpu_modified_ranges = std::move(spare_gpu_modified_ranges.back());
+        spare_gpu_modified_ranges.pop_back();
+    }
 }
 
 template <class P>
@@ -533,9 +572,7 @@ void BufferCache<P>::CommitAsyncFlushesHigh() {
         auto& current_intervals = *it;
         auto next_it = std::next(it);
         while (next_it != committed_gpu_modified_ranges.end()) {
-            next_it->ForEach([&current_intervals](DAddr start, DAddr end) {
-                current_intervals.Subtract(start, end - start);
-            });
+            current_intervals.Subtract(*next_it);
             next_it++;
         }
         it++;
@@ -581,6 +618,10 @@ void BufferCache<P>::CommitAsyncFlushesHigh() {
             });
         });
     }
+    for (Common::RangeSet<DAddr>& range_set : committed_gpu_modified_ranges) {
+        range_set.Clear();
+        spare_gpu_modified_ranges.push_back(std::move(range_set));
+    }
     committed_gpu_modified_ranges.clear();
     if (downloads.empty()) {
         async_buffers.emplace_back(std::optional<Async_Buffer>{});
@@ -656,23 +697,7 @@ bool BufferCache<P>::IsRegionGpuModified(DAddr addr, size_t size) {
 
 template <class P>
 bool BufferCache<P>::IsRegionRegistered(DAddr addr, size_t size) {
-    const DAddr end_addr = addr + size;
-    const u64 page_end = Common::DivCeil(end_addr, CACHING_PAGESIZE);
-    for (u64 page = addr >> CACHING_PAGEBITS; page < page_end;) {
-        const BufferId buffer_id = page_table[page];
-        if (!buffer_id) {
-            ++page;
-            continue;
-        }
-        Buffer& buffer = slot_buffers[buffer_id];
-        const DAddr buf_start_addr = buffer.CpuAddr();
-        const DAddr buf_end_addr = buf_start_addr + buffer.SizeBytes();
-        if (buf_start_addr < end_addr && addr < buf_end_addr) {
-            return true;
-        }
-        page = Common::DivCeil(end_addr, CACHING_PAGESIZE);
-    }
-    return false;
+    return buffer_index.FindFirstOverlap(addr, addr + size).has_value();
 }
 
 template <class P>
@@ -789,12 +814,32 @@ void BufferCache<P>::BindHostGraphicsUniformBuffer(size_t stage, u32 index, u32
     const Binding& binding = channel_state->uniform_buffers[stage][index];
     const DAddr device_addr = binding.device_addr;
     const u32 size = std::min(binding.size, (*channel_state->uniform_buffer_sizes)[stage][index]);
+    const bool is_inline = ((channel_state->inline_uniform_buffers[stage] >> index) & 1) != 0;
     Buffer& buffer = slot_buffers[binding.buffer_id];
-    TouchBuffer(buffer, binding.buffer_id);
+    if (!is_inline) {
+        TouchBuffer(buffer, binding.buffer_id);
+    }
     const bool use_fast_buffer = binding.buffer_id != NULL_BUFFER_ID &&
                                  size <= channel_state->uniform_buffer_skip_cache_size &&
                                  !memory_tracker.IsRegionGpuModified(device_addr, size);
-    if (use_fast_buffer) {
+    std::span<const u8> inline_data;
+    if (is_inline) {
+        // Inline buffers have no cached buffer to synchronize, count them as hits when their
+        // contents did not change since the last draw so static buffers go back to the cache
+        inline_data = ImmediateBufferWithData(device_addr, size);
+        const u64 hash =
+            Common::CityHash64(reinterpret_cast<const char*>(inline_data.data()), size);
+        u64& last_hash = channel_state->inline_uniform_buffer_hashes[stage][index];
+        if (hash == last_hash) {
+            ++channel_state->uniform_cache_hits[0];
+        }
+        ++channel_state->uniform_cache_shots[0];
+        last_hash = hash;
+        ++draw_statistics.inline_uniform_buffers;
+    } else if (use_fast_buffer) {
+        ++draw_statistics.streamed_uniform_buffers;
+    }
+    if (is_inline || use_fast_buffer) {
         if constexpr (IS_OPENGL) {
             if (runtime.HasFastBufferSubData()) {
                 // Fast path for Nvidia
@@ -807,7 +852,8 @@ void BufferCache<P>::BindHostGraphicsUniformBuffer(size_t stage, u32 index, u32
                     channel_state->uniform_buffer_binding_sizes[stage][binding_index] = size;
                     runtime.BindFastUniformBuffer(stage, binding_index, size);
                 }
-                const auto span = ImmediateBufferWithData(device_addr, size);
+                const auto span =
+                    is_inline ? inline_data : ImmediateBufferWithData(device_addr, size);
                 runtime.PushFastUniformBuffer(stage, binding_index, span);
                 return;
             }
@@ -818,10 +864,15 @@ void BufferCache<P>::BindHostGraphicsUniformBuffer(size_t stage, u32 index, u32
         }
         // Stream buffer path to avoid stalling on non-Nvidia drivers or Vulkan
         const std::span<u8> span = runtime.BindMappedUniformBuffer(stage, binding_index, size);
-        device_memory.ReadBlockUnsafe(device_addr, span.data(), size);
+        if (is_inline) {
+            std::memcpy(span.data(), inline_data.data(), size);
+        } else {
+            device_memory.ReadBlockUnsafe(device_addr, span.data(), size);
+        }
         return;
     }
     // Classic cached path
+    ++draw_statistics.cached_uniform_buffers;
     const bool sync_cached = SynchronizeBuffer(buffer, device_addr, size);
     if (sync_cached) {
         ++channel_state->uniform_cache_hits[0];
@@ -1167,10 +1218,19 @@ template <class P>
 void BufferCache<P>::UpdateUniformBuffers(size_t stage) {
     ForEachEnabledBit(channel_state->enabled_uniform_buffer_masks[stage], [&](u32 index) {
         Binding& binding = channel_state->uniform_buffers[stage][index];
-        if (binding.buffer_id) {
+        u32& inline_mask = channel_state->inline_uniform_buffers[stage];
+        const bool was_inline = ((inline_mask >> index) & 1) != 0;
+        if (binding.buffer_id && !was_inline) {
             // Already updated
             return;
         }
+        // Inline buffers are checked on every draw, they can't be streamed once the GPU writes them
+        if (CanInlineUniformBuffer(stage, index, binding)) {
+            inline_mask |= 1U << index;
+            binding.buffer_id = NULL_BUFFER_ID;
+            return;
+        }
+        inline_mask &= ~(1U << index);
         // Mark as dirty
         if constexpr (HAS_PERSISTENT_UNIFORM_BUFFER_BINDINGS) {
             channel_state->dirty_uniform_buffers[stage] |= 1U << index;
@@ -1180,6 +1240,15 @@ void BufferCache<P>::UpdateUniformBuffers(size_t stage) {
     });
 }
 
+template <class P>
+bool BufferCache<P>::CanInlineUniformBuffer(size_t stage, u32 index, const Binding& binding) {
+    const u32 size = std::min(binding.size, (*channel_state->uniform_buffer_sizes)[stage][index]);
+    const u32 max_size =
+        std::min(INLINE_UNIFORM_BUFFER_SIZE, channel_state->uniform_buffer_skip_cache_size);
+    return binding.device_addr != 0 && size != 0 && size <= max_size &&
+           !memory_tracker.IsRegionGpuModified(binding.device_addr, size);
+}
+
 template <class P>
 void BufferCache<P>::UpdateStorageBuffers(size_t stage) {
     ForEachEnabledBit(channel_state->enabled_storage_buffers[stage], [&](u32 index) {
@@ -1273,14 +1342,13 @@ BufferId BufferCache<P>::FindBuffer(DAddr device_addr, u32 size) {
     if (device_addr == 0) {
         return NULL_BUFFER_ID;
     }
-    const u64 page = device_addr >> CACHING_PAGEBITS;
-    const BufferId buffer_id = page_table[page];
-    if (!buffer_id) {
+    const auto range = buffer_index.Find(device_addr);
+    if (!range) {
         return CreateBuffer(device_addr, size);
     }
-    const Buffer& buffer = slot_buffers[buffer_id];
+    const Buffer& buffer = slot_buffers[range->id];
     if (buffer.IsInBounds(device_addr, size)) {
-        return buffer_id;
+        return range->id;
     }
     return CreateBuffer(device_addr, size);
 }
@@ -1292,17 +1360,18 @@ typename BufferCache<P>::OverlapResult BufferCache<P>::ResolveOverlaps(DAddr dev
     boost::container::small_vector<BufferId, 16> overlap_ids;
     DAddr begin = device_addr;
     DAddr end = device_addr + wanted_size;
+    DAddr scan_addr = device_addr;
     int stream_score = 0;
     bool has_stream_leap = false;
     auto expand_begin = [&](DAddr add_value) {
         static constexpr DAddr min_page = CACHING_PAGESIZE + Core::DEVICE_PAGESIZE;
         if (add_value > begin - min_page) {
             begin = min_page;
-            device_addr = Core::DEVICE_PAGESIZE;
+            scan_addr = begin;
             return;
         }
         begin -= add_value;
-        device_addr = begin - CACHING_PAGESIZE;
+        scan_addr = begin;
     };
     auto expand_end = [&](DAddr add_value) {
         static constexpr DAddr max_page = 1ULL << Tegra::MaxwellDeviceMemoryManager::AS_BITS;
@@ -1320,12 +1389,13 @@ typename BufferCache<P>::OverlapResult BufferCache<P>::ResolveOverlaps(DAddr dev
             .has_stream_leap = has_stream_leap,
         };
     }
-    for (; device_addr >> CACHING_PAGEBITS < Common::DivCeil(end, CACHING_PAGESIZE);
-         device_addr += CACHING_PAGESIZE) {
-        const BufferId overlap_id = page_table[device_addr >> CACHING_PAGEBITS];
-        if (!overlap_id) {
-            continue;
+    while (scan_addr < end) {
+        const auto range = buffer_index.FindFirstOverlap(scan_addr, end);
+        if (!range) {
+            break;
         }
+        scan_addr = range->end;
+        const BufferId overlap_id = range->id;
         Buffer& overlap = slot_buffers[overlap_id];
         if (overlap.IsPicked()) {
             continue;
@@ -1380,15 +1450,55 @@ void BufferCache<P>::JoinOverlap(BufferId new_buffer_id, BufferId overlap_id,
     });
     new_buffer.MarkUsage(copies[0].dst_offset, copies[0].size);
     runtime.CopyBuffer(new_buffer, overlap, copies, true);
+    ++join_statistics.num_joins;
+    join_statistics.bytes_copied += overlap.SizeBytes();
     DeleteBuffer(overlap_id, true);
 }
 
+template <class P>
+void BufferCache<P>::ReserveGrowth(OverlapResult& overlap, DAddr device_addr,
+                                   DAddr device_addr_end) {
+    DAddr joined_begin = overlap.end;
+    DAddr joined_end = overlap.begin;
+    for (const BufferId overlap_id : overlap.ids) {
+        const Buffer& buffer = slot_buffers[overlap_id];
+        joined_begin = std::min(joined_begin, buffer.CpuAddr());
+        joined_end = std::max(joined_end, buffer.CpuAddr() + buffer.SizeBytes());
+    }
+    // Reserve as much address space as the joined buffer already covers in the direction it is
+    // growing to, so progressively touched ranges don't join again on every access.
+    // The reserve never reaches the neighbouring buffers to avoid cascading joins.
+    const u64 reserve = std::min(overlap.end - overlap.begin, MAX_GROWTH_RESERVE);
+    if (device_addr_end > joined_end) {
+        static constexpr DAddr max_page = 1ULL << Tegra::MaxwellDeviceMemoryManager::AS_BITS;
+        const auto next = buffer_index.FindNext(overlap.end);
+        const DAddr limit = next ? next->begin : max_page;
+        const DAddr new_end = limit - overlap.end > reserve ? overlap.end + reserve : limit;
+        join_statistics.bytes_reserved += new_end - overlap.end;
+        overlap.end = new_end;
+    }
+    if (device_addr < joined_begin) {
+        static constexpr DAddr min_page = CACHING_PAGESIZE + Core::DEVICE_PAGESIZE;
+        const auto previous = buffer_index.FindPrevious(overlap.begin);
+        const DAddr limit = std::max(previous ? previous->end : min_page, min_page);
+        if (overlap.begin > limit) {
+            const DAddr new_begin =
+                overlap.begin - limit > reserve ? overlap.begin - reserve : limit;
+            join_statistics.bytes_reserved += overlap.begin - new_begin;
+            overlap.begin = new_begin;
+        }
+    }
+}
+
 template <class P>
 BufferId BufferCache<P>::CreateBuffer(DAddr device_addr, u32 wanted_size) {
     DAddr device_addr_end = Common::AlignUp(device_addr + wanted_size, CACHING_PAGESIZE);
     device_addr = Common::AlignDown(device_addr, CACHING_PAGESIZE);
     wanted_size = static_cast<u32>(device_addr_end - device_addr);
-    const OverlapResult overlap = ResolveOverlaps(device_addr, wanted_size);
+    OverlapResult overlap = ResolveOverlaps(device_addr, wanted_size);
+    if (!overlap.ids.empty() && !overlap.has_stream_leap) {
+        ReserveGrowth(overlap, device_addr, device_addr_end);
+    }
     const u32 size = static_cast<u32>(overlap.end - overlap.begin);
     const BufferId new_buffer_id = slot_buffers.insert(runtime, overlap.begin, size);
     auto& new_buffer = slot_buffers[new_buffer_id];
@@ -1427,14 +1537,10 @@ void BufferCache<P>::ChangeRegister(BufferId buffer_id) {
     }
     const DAddr device_addr_begin = buffer.CpuAddr();
     const DAddr device_addr_end = device_addr_begin + size;
-    const u64 page_begin = device_addr_begin / CACHING_PAGESIZE;
-    const u64 page_end = Common::DivCeil(device_addr_end, CACHING_PAGESIZE);
-    for (u64 page = page_begin; page != page_end; ++page) {
-        if constexpr (insert) {
-            page_table[page] = buffer_id;
-        } else {
-            page_table[page] = BufferId{};
-        }
+    if constexpr (insert) {
+        buffer_index.Insert(device_addr_begin, device_addr_end, buffer_id);
+    } else {
+        buffer_index.Erase(device_addr_end, buffer_id);
     }
 }
 
@@ -1774,6 +1880,18 @@ std::span<u8> BufferCache<P>::ImmediateBuffer(size_t wanted_capacity) {
     return std::span<u8>(immediate_buffer_alloc.data(), wanted_capacity);
 }
 
+template <class P>
+std::chrono::steady_clock::time_point BufferCache<P>::StartDrawTimer() const {
+    return time_draws ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+}
+
+template <class P>
+void BufferCache<P>::StopDrawTimer(std::chrono::steady_clock::time_point start_time) {
+    if (time_draws) {
+        draw_statistics.cpu_time += std::chrono::steady_clock::now() - start_time;
+    }
+}
+
 template <class P>
 bool BufferCache<P>::HasFastUniformBufferBound(size_t stage, u32 binding_index) const noexcept {
     if constexpr (IS_OPENGL) {
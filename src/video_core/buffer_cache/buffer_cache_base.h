@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -23,6 +24,7 @@
 #include "common/settings.h"
 #include "common/slot_vector.h"
 #include "video_core/buffer_cache/buffer_base.h"
+#include "video_core/buffer_cache/buffer_index.h"
 #include "video_core/control/channel_state_cache.h"
 #include "video_core/delayed_destruction_ring.h"
 #include "video_core/dirty_flags.h"
@@ -74,6 +76,9 @@ enum class ObtainBufferOperation : u32 {
 
 static constexpr BufferId NULL_BUFFER_ID{0};
 static constexpr u32 DEFAULT_SKIP_CACHE_SIZE = static_cast<u32>(4_KiB);
+/// Graphics uniform buffers up to this size are streamed on every draw without a cached buffer
+/// while the uniform cache statistics prefer streaming
+static constexpr u32 INLINE_UNIFORM_BUFFER_SIZE = static_cast<u32>(1_KiB);
 
 struct Binding {
     DAddr device_addr{};
@@ -148,6 +153,9 @@ public:
 
     std::array<u32, NUM_STAGES> dirty_uniform_buffers{};
     std::array<u32, NUM_STAGES> fast_bound_uniform_buffers{};
+    std::array<u32, NUM_STAGES> inline_uniform_buffers{};
+    std::array<std::array<u64, NUM_GRAPHICS_UNIFORM_BUFFERS>, NUM_STAGES>
+        inline_uniform_buffer_hashes{};
     std::array<std::array<u32, NUM_GRAPHICS_UNIFORM_BUFFERS>, NUM_STAGES>
         uniform_buffer_binding_sizes{};
 };
@@ -159,6 +167,9 @@ class BufferCache : public VideoCommon::ChannelSetupCaches<BufferCacheChannelInf
     static constexpr u32 CACHING_PAGEBITS = 16;
     static constexpr u64 CACHING_PAGESIZE = u64{1} << CACHING_PAGEBITS;
 
+    // Upper bound of the address space a buffer reserves on the side it grows to when joining.
+    static constexpr u64 MAX_GROWTH_RESERVE = CACHING_PAGESIZE * 64;
+
     static constexpr bool IS_OPENGL = P::IS_OPENGL;
     static constexpr bool HAS_PERSISTENT_UNIFORM_BUFFER_BINDINGS =
         P::HAS_PERSISTENT_UNIFORM_BUFFER_BINDINGS;
@@ -321,18 +332,14 @@ private:
 
     template <typename Func>
     void ForEachBufferInRange(DAddr device_addr, u64 size, Func&& func) {
-        const u64 page_end = Common::DivCeil(device_addr + size, CACHING_PAGESIZE);
-        for (u64 page = device_addr >> CACHING_PAGEBITS; page < page_end;) {
-            const BufferId buffer_id = page_table[page];
-            if (!buffer_id) {
-                ++page;
-                continue;
+        const DAddr end_addr = device_addr + size;
+        for (DAddr addr = device_addr; addr < end_addr;) {
+            const auto range = buffer_index.FindFirstOverlap(addr, end_addr);
+            if (!range) {
+                break;
             }
-            Buffer& buffer = slot_buffers[buffer_id];
-            func(buffer_id, buffer);
-
-            const DAddr end_addr = buffer.CpuAddr() + buffer.SizeBytes();
-            page = Common::DivCeil(end_addr, CACHING_PAGESIZE);
+            func(range->id, slot_buffers[range->id]);
+            addr = range->end;
         }
     }
 
@@ -379,6 +386,8 @@ private:
 
     void UpdateUniformBuffers(size_t stage);
 
+    [[nodiscard]] bool CanInlineUniformBuffer(size_t stage, u32 index, const Binding& binding);
+
     void UpdateStorageBuffers(size_t stage);
 
     void UpdateTextureBuffers(size_t stage);
@@ -401,6 +410,8 @@ private:
 
     void JoinOverlap(BufferId new_buffer_id, BufferId overlap_id, bool accumulate_stream_score);
 
+    void ReserveGrowth(OverlapResult& overlap, DAddr device_addr, DAddr device_addr_end);
+
     [[nodiscard]] BufferId CreateBuffer(DAddr device_addr, u32 wanted_size);
 
     void Register(BufferId buffer_id);
@@ -440,6 +451,10 @@ private:
 
     [[nodiscard]] bool HasFastUniformBufferBound(size_t stage, u32 binding_index) const noexcept;
 
+    [[nodiscard]] std::chrono::steady_clock::time_point StartDrawTimer() const;
+
+    void StopDrawTimer(std::chrono::steady_clock::time_point start_time);
+
     void ClearDownload(DAddr base_addr, u64 size);
 
     void InlineMemoryImplementation(DAddr dest_address, size_t copy_size,
@@ -458,6 +473,7 @@ private:
     Common::RangeSet<DAddr> uncommitted_gpu_modified_ranges;
     Common::RangeSet<DAddr> gpu_modified_ranges;
     std::deque<Common::RangeSet<DAddr>> committed_gpu_modified_ranges;
+    std::vector<Common::RangeSet<DAddr>> spare_gpu_modified_ranges;
 
     // Async Buffers
     Common::OverlapRangeSet<DAddr> async_downloads;
@@ -481,7 +497,25 @@ private:
     u64 critical_memory = 0;
     BufferId inline_buffer_id;
 
-    std::array<BufferId, ((1ULL << 34) >> CACHING_PAGEBITS)> page_table;
+    struct DrawStatistics {
+        u64 num_draws = 0;
+        u64 inline_uniform_buffers = 0;
+        u64 streamed_uniform_buffers = 0;
+        u64 cached_uniform_buffers = 0;
+        std::chrono::nanoseconds cpu_time{};
+    };
+    DrawStatistics draw_statistics;
+    /// Draws are only timed while extended logging is enabled, the counters are always kept
+    bool time_draws = false;
+
+    struct JoinStatistics {
+        u64 num_joins = 0;
+        u64 bytes_copied = 0;
+        u64 bytes_reserved = 0;
+    };
+    JoinStatistics join_statistics;
+
+    BufferIndex<BufferId> buffer_index;
     Common::ScratchBuffer<u8> tmp_buffer;
 };
 
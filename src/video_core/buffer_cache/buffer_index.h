@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <optional>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/// Ordered index of the address ranges covered by cached buffers.
+/// Cached buffers never overlap, so keying the ranges by their end address is enough to find the
+/// buffer containing an address or all the buffers overlapping a range in logarithmic time.
+template <typename Id>
+class BufferIndex {
+public:
+    struct Range {
+        u64 begin;
+        u64 end;
+        Id id;
+    };
+
+    /// Registers the range [begin, end) as owned by id
+    void Insert(u64 begin, u64 end, Id id) {
+        ranges.insert_or_assign(end, Entry{begin, id});
+    }
+
+    /// Unregisters the range [begin, end) if it is still owned by id
+    void Erase(u64 end, Id id) {
+        const auto it = ranges.find(end);
+        if (it != ranges.end() && it->second.id == id) {
+            ranges.erase(it);
+        }
+    }
+
+    /// Returns the range containing addr
+    [[nodiscard]] std::optional<Range> Find(u64 addr) const {
+        const auto it = ranges.upper_bound(addr);
+        if (it == ranges.end() || it->second.begin > addr) {
+            return std::nullopt;
+        }
+        return Range{it->second.begin, it->first, it->second.id};
+    }
+
+    /// Returns the first range overlapping [begin, end)
+    [[nodiscard]] std::optional<Range> FindFirstOverlap(u64 begin, u64 end) const {
+        const auto it = ranges.upper_bound(begin);
+        if (it == ranges.end() || it->second.begin >= end) {
+            return std::nullopt;
+        }
+        return Range{it->second.begin, it->first, it->second.id};
+    }
+
+    /// Returns the first range starting at or after addr
+    [[nodiscard]] std::optional<Range> FindNext(u64 addr) const {
+        for (auto it = ranges.upper_bound(addr); it != ranges.end(); ++it) {
+            if (it->second.begin >= addr) {
+                return Range{it->second.begin, it->first, it->second.id};
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Returns the last range ending at or before addr
+    [[nodiscard]] std::optional<Range> FindPrevious(u64 addr) const {
+        auto it = ranges.upper_bound(addr);
+        if (it == ranges.begin()) {
+            return std::nullopt;
+        }
+        --it;
+        return Range{it->second.begin, it->first, it->second.id};
+    }
+
+    /// Calls func for every range overlapping [begin, end) in address order
+    template <typename Func>
+    void ForEachOverlap(u64 begin, u64 end, Func&& func) const {
+        for (auto it = ranges.upper_bound(begin); it != ranges.end(); ++it) {
+            if (it->second.begin >= end) {
+                break;
+            }
+            func(Range{it->second.begin, it->first, it->second.id});
+        }
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return ranges.size();
+    }
+
+private:
+    struct Entry {
+        u64 begin;
+        Id id;
+    };
+
+    std::map<u64, Entry> ranges;
+};
+
+} // namespace VideoCommon
@@ -4,14 +4,14 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <cstring>
-#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
-#include <queue>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/microprofile.h"
@@ -22,6 +22,7 @@
 #include "video_core/gpu.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/host1x/syncpoint_manager.h"
+#include "video_core/operation_ring.h"
 #include "video_core/rasterizer_interface.h"
 
 namespace VideoCommon {
@@ -63,48 +64,20 @@ public:
     }
 
     void SignalReference() {
-        std::function<void()> do_nothing([] {});
-        SignalFence(std::move(do_nothing));
+        SignalFenceImpl(Operation{});
     }
 
     void SyncOperation(std::function<void()>&& func) {
-        uncommitted_operations.emplace_back(std::move(func));
+        uncommitted_operations.push_back(Operation::Callback(std::move(func)));
     }
 
     void SignalFence(std::function<void()>&& func) {
-        bool delay_fence = Settings::IsGPULevelHigh();
-        if constexpr (!can_async_check) {
-            TryReleasePendingFences<false>();
-        }
-        const bool should_flush = ShouldFlush();
-        CommitAsyncFlushes();
-        TFence new_fence = CreateFence(!should_flush);
-        if constexpr (can_async_check) {
-            guard.lock();
-        }
-        if (delay_fence) {
-            uncommitted_operations.emplace_back(std::move(func));
-        }
-        pending_operations.emplace_back(std::move(uncommitted_operations));
-        QueueFence(new_fence);
-        if (!delay_fence) {
-            func();
-        }
-        fences.push(std::move(new_fence));
-        if (should_flush) {
-            rasterizer.FlushCommands();
-        }
-        if constexpr (can_async_check) {
-            guard.unlock();
-            cv.notify_all();
-        }
-        rasterizer.InvalidateGPUCache();
+        SignalFenceImpl(Operation::Callback(std::move(func)));
     }
 
     void SignalSyncPoint(u32 value) {
         syncpoint_manager.IncrementGuest(value);
-        std::function<void()> func([this, value] { syncpoint_manager.IncrementHost(value); });
-        SignalFence(std::move(func));
+        SignalFenceImpl(Operation{.type = Operation::Type::SyncPoint, .value = value});
     }
 
     void WaitPendingFences([[maybe_unused]] bool force) {
@@ -114,18 +87,12 @@ public:
             if (!force) {
                 return;
             }
-            std::mutex wait_mutex;
-            std::condition_variable wait_cv;
-            std::atomic<bool> wait_finished{};
-            std::function<void()> func([&] {
-                std::scoped_lock lk(wait_mutex);
-                wait_finished.store(true, std::memory_order_relaxed);
-                wait_cv.notify_all();
-            });
-            SignalFence(std::move(func));
-            std::unique_lock lk(wait_mutex);
-            wait_cv.wait(
-                lk, [&wait_finished] { return wait_finished.load(std::memory_order_relaxed); });
+            const u64 sequence = SignalFenceImpl(Operation{});
+            u64 completed = completed_sequence.load(std::memory_order_acquire);
+            while (completed < sequence) {
+                completed_sequence.wait(completed, std::memory_order_acquire);
+                completed = completed_sequence.load(std::memory_order_acquire);
+            }
         }
     }
 
@@ -167,28 +134,89 @@ protected:
     TQueryCache& query_cache;
 
 private:
+    /// Work released when a fence is reached, typed so the common cases don't allocate
+    struct Operation {
+        enum class Type : u32 {
+            Reference,
+            SyncPoint,
+            Callback,
+        };
+
+        static Operation Callback(std::function<void()>&& func) {
+            return Operation{.type = Type::Callback, .callback = std::move(func)};
+        }
+
+        Type type{Type::Reference};
+        u32 value{};
+        std::function<void()> callback;
+    };
+
+    using PendingFence = typename PendingFenceRing<TFence, Operation>::PendingFence;
+
+    /// Queues a fence releasing the uncommitted operations and the given one.
+    /// Returns the sequence number to wait for the operation, or zero when it already ran.
+    u64 SignalFenceImpl(Operation&& operation) {
+        const bool delay_fence = Settings::IsGPULevelHigh();
+        if constexpr (!can_async_check) {
+            TryReleasePendingFences<false>();
+        }
+        const bool should_flush = ShouldFlush();
+        CommitAsyncFlushes();
+        TFence new_fence = CreateFence(!should_flush);
+        if constexpr (can_async_check) {
+            guard.lock();
+        }
+        if (delay_fence) {
+            uncommitted_operations.push_back(std::move(operation));
+        }
+        QueueFence(new_fence);
+        if (!delay_fence) {
+            Execute(operation);
+        }
+        const u64 sequence = fences.Push(std::move(new_fence), uncommitted_operations);
+        uncommitted_operations.clear();
+        if (should_flush) {
+            rasterizer.FlushCommands();
+        }
+        if constexpr (can_async_check) {
+            guard.unlock();
+            cv.notify_all();
+        }
+        rasterizer.InvalidateGPUCache();
+        return delay_fence ? sequence : 0;
+    }
+
+    void Execute(Operation& operation) {
+        switch (operation.type) {
+        case Operation::Type::Reference:
+            break;
+        case Operation::Type::SyncPoint:
+            syncpoint_manager.IncrementHost(operation.value);
+            break;
+        case Operation::Type::Callback:
+            operation.callback();
+            break;
+        }
+    }
+
     template <bool force_wait>
     void TryReleasePendingFences() {
-        while (!fences.empty()) {
-            TFence& current_fence = fences.front();
-            if (ShouldWait() && !IsFenceSignaled(current_fence)) {
+        while (!fences.Empty()) {
+            PendingFence& current = fences.Front();
+            if (ShouldWait() && !IsFenceSignaled(current.fence)) {
                 if constexpr (force_wait) {
-                    WaitFence(current_fence);
+                    WaitFence(current.fence);
                 } else {
                     return;
                 }
             }
             PopAsyncFlushes();
-            auto operations = std::move(pending_operations.front());
-            pending_operations.pop_front();
-            for (auto& operation : operations) {
-                operation();
-            }
+            PendingFence released =
+                fences.PopFront([this](Operation&& operation) { Execute(operation); });
             {
                 std::unique_lock lock(ring_guard);
-                delayed_destruction_ring.Push(std::move(current_fence));
+                delayed_destruction_ring.Push(std::move(released.fence));
             }
-            fences.pop();
         }
     }
 
@@ -204,31 +232,43 @@ private:
         Common::SetCurrentThreadName(name.c_str());
         Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
 
-        TFence current_fence;
-        std::deque<std::function<void()>> current_operations;
+        // Reused between batches, releasing fences doesn't allocate once they are large enough
+        std::vector<PendingFence> current_fences;
+        std::vector<Operation> current_operations;
         while (!stop_token.stop_requested()) {
             {
                 std::unique_lock lock(guard);
-                cv.wait(lock, [&] { return stop_token.stop_requested() || !fences.empty(); });
+                cv.wait(lock, [&] { return stop_token.stop_requested() || !fences.Empty(); });
                 if (stop_token.stop_requested()) [[unlikely]] {
                     return;
                 }
-                current_fence = std::move(fences.front());
-                current_operations = std::move(pending_operations.front());
-                fences.pop();
-                pending_operations.pop_front();
-            }
-            if (!current_fence->IsStubbed()) {
-                WaitFence(current_fence);
+                // Take every queued fence at once to release them without locking again
+                while (!fences.Empty()) {
+                    current_fences.push_back(fences.PopFront([&](Operation&& operation) {
+                        current_operations.push_back(std::move(operation));
+                    }));
+                }
             }
-            PopAsyncFlushes();
-            for (auto& operation : current_operations) {
-                operation();
+            size_t operation_index = 0;
+            for (PendingFence& current : current_fences) {
+                if (!current.fence->IsStubbed()) {
+                    WaitFence(current.fence);
+                }
+                PopAsyncFlushes();
+                for (size_t index = 0; index < current.num_operations; ++index) {
+                    Execute(current_operations[operation_index++]);
+                }
+                completed_sequence.store(current.sequence, std::memory_order_release);
+                completed_sequence.notify_all();
             }
             {
                 std::unique_lock lock(ring_guard);
-                delayed_destruction_ring.Push(std::move(current_fence));
+                for (PendingFence& current : current_fences) {
+                    delayed_destruction_ring.Push(std::move(current.fence));
+                }
             }
+            current_fences.clear();
+            current_operations.clear();
         }
     }
 
@@ -262,9 +302,9 @@ private:
         query_cache.CommitAsyncFlushes();
     }
 
-    std::queue<TFence> fences;
-    std::deque<std::function<void()>> uncommitted_operations;
-    std::deque<std::deque<std::function<void()>>> pending_operations;
+    PendingFenceRing<TFence, Operation> fences;
+    std::vector<Operation> uncommitted_operations;
+    std::atomic<u64> completed_sequence{};
 
     std::mutex guard;
     std::mutex ring_guard;
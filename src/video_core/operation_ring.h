@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/// FIFO of movable objects stored in a growable power of two ring.
+/// Storage is only reallocated when the ring grows, so a steady stream of pushes and pops doesn't
+/// allocate once the ring has reached its working size.
+template <typename T, typename Allocator = std::allocator<T>>
+class OperationRing {
+public:
+    void Push(T&& object) {
+        if (count == storage.size()) {
+            Grow();
+        }
+        storage[(head + count) & (storage.size() - 1)] = std::move(object);
+        ++count;
+    }
+
+    [[nodiscard]] T& Front() {
+        return storage[head];
+    }
+
+    /// Removes the front object and returns it
+    T PopFront() {
+        T object{std::exchange(storage[head], T{})};
+        head = (head + 1) & (storage.size() - 1);
+        --count;
+        return object;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return count == 0;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return count;
+    }
+
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return storage.size();
+    }
+
+private:
+    void Grow() {
+        std::vector<T, Allocator> new_storage(std::max<size_t>(std::bit_ceil(count + 1), 16),
+                                              storage.get_allocator());
+        for (size_t index = 0; index < count; ++index) {
+            new_storage[index] = std::move(storage[(head + index) & (storage.size() - 1)]);
+        }
+        storage = std::move(new_storage);
+        head = 0;
+    }
+
+    std::vector<T, Allocator> storage;
+    size_t head{};
+    size_t count{};
+};
+
+/// Fences in signal order, each with the operations it releases when it is reached.
+/// Accesses are not synchronized, producers and the releasing thread have to lock around them.
+template <typename Fence, typename Operation, typename Allocator = std::allocator<Operation>>
+class PendingFenceRing {
+public:
+    struct PendingFence {
+        Fence fence;
+        size_t num_operations;
+        u64 sequence;
+    };
+
+    /// Queues a fence releasing the given operations, moving them.
+    /// Returns the sequence number of the fence, starting at one.
+    u64 Push(Fence&& fence, std::span<Operation> operations) {
+        for (Operation& operation : operations) {
+            pending_operations.Push(std::move(operation));
+        }
+        const u64 sequence = ++signaled_sequence;
+        fences.Push(PendingFence{std::move(fence), operations.size(), sequence});
+        return sequence;
+    }
+
+    [[nodiscard]] PendingFence& Front() {
+        return fences.Front();
+    }
+
+    /// Removes the front fence and returns it, passing the operations it releases to func in order
+    template <typename Func>
+    PendingFence PopFront(Func&& func) {
+        const size_t num_operations = fences.Front().num_operations;
+        for (size_t index = 0; index < num_operations; ++index) {
+            func(pending_operations.PopFront());
+        }
+        return fences.PopFront();
+    }
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return fences.Empty();
+    }
+
+private:
+    using FenceAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<PendingFence>;
+
+    OperationRing<PendingFence, FenceAllocator> fences;
+    OperationRing<Operation, Allocator> pending_operations;
+    u64 signaled_sequence{};
+};
+
+} // namespace VideoCommon
@@ -2,10 +2,12 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <cstring>
+#include <utility>
 
 #include "common/cityhash.h"
 #include "common/settings.h" // for enum class Settings::ShaderBackend
 #include "video_core/renderer_opengl/gl_compute_pipeline.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_shader_util.h"
 
@@ -29,19 +31,20 @@ bool ComputePipelineKey::operator==(const ComputePipelineKey& rhs) const noexcep
 
 ComputePipeline::ComputePipeline(const Device& device, TextureCache& texture_cache_,
                                  BufferCache& buffer_cache_, ProgramManager& program_manager_,
-                                 const Shader::Info& info_, std::string code,
+                                 ProgramBinaryCache& binary_cache_, const Shader::Info& info_,
+                                 std::string code,
                                  std::vector<u32> code_v, bool force_context_flush)
     : texture_cache{texture_cache_}, buffer_cache{buffer_cache_},
-      program_manager{program_manager_}, info{info_} {
+      program_manager{program_manager_}, binary_cache{binary_cache_}, info{info_} {
     switch (device.GetShaderBackend()) {
     case Settings::ShaderBackend::Glsl:
-        source_program = CreateProgram(code, GL_COMPUTE_SHADER);
+        source_program = binary_cache.CreateProgram(code, GL_COMPUTE_SHADER, binary_key);
         break;
     case Settings::ShaderBackend::Glasm:
         assembly_program = CompileProgram(code, GL_COMPUTE_PROGRAM_NV);
         break;
     case Settings::ShaderBackend::SpirV:
-        source_program = CreateProgram(code_v, GL_COMPUTE_SHADER);
+        source_program = binary_cache.CreateProgram(code_v, GL_COMPUTE_SHADER, binary_key);
         break;
     }
     std::copy_n(info.constant_buffer_used_sizes.begin(), uniform_buffer_sizes.size(),
@@ -155,6 +158,10 @@ void ComputePipeline::Configure() {
     if (!is_built) {
         WaitForBuild();
     }
+    if (binary_key != 0) {
+        // Retrieving the binary waits for the link, which the first dispatch needs anyway
+        binary_cache.Save(std::exchange(binary_key, 0), source_program.handle);
+    }
     if (assembly_program.handle != 0) {
         program_manager.BindComputeAssemblyProgram(assembly_program.handle);
     } else {
@@ -27,6 +27,7 @@ struct Info;
 namespace OpenGL {
 
 class Device;
+class ProgramBinaryCache;
 class ProgramManager;
 
 struct ComputePipelineKey {
@@ -50,7 +51,8 @@ class ComputePipeline {
 public:
     explicit ComputePipeline(const Device& device, TextureCache& texture_cache_,
                              BufferCache& buffer_cache_, ProgramManager& program_manager_,
-                             const Shader::Info& info_, std::string code, std::vector<u32> code_v,
+                             ProgramBinaryCache& binary_cache_, const Shader::Info& info_,
+                             std::string code, std::vector<u32> code_v,
                              bool force_context_flush = false);
 
     void Configure();
@@ -77,9 +79,11 @@ private:
     Tegra::MemoryManager* gpu_memory;
     Tegra::Engines::KeplerCompute* kepler_compute;
     ProgramManager& program_manager;
+    ProgramBinaryCache& binary_cache;
 
     Shader::Info info;
     OGLProgram source_program;
+    u64 binary_key{};
     OGLAssemblyProgram assembly_program;
     VideoCommon::ComputeUniformBufferSizes uniform_buffer_sizes{};
 
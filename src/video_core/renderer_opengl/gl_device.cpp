@@ -209,6 +209,7 @@ Device::Device(Core::Frontend::EmuWindow& emu_window) {
     has_amd_shader_half_float = GLAD_GL_AMD_gpu_shader_half_float;
     has_sparse_texture_2 = GLAD_GL_ARB_sparse_texture2;
     has_draw_texture = GLAD_GL_NV_draw_texture;
+    has_parallel_shader_compile = GLAD_GL_KHR_parallel_shader_compile;
     warp_size_potentially_larger_than_guest = !is_nvidia && !is_intel;
     need_fastmath_off = is_nvidia;
     can_report_memory = GLAD_GL_NVX_gpu_memory_info;
@@ -244,6 +245,11 @@ Device::Device(Core::Frontend::EmuWindow& emu_window) {
     use_asynchronous_shaders =
         Settings::values.use_asynchronous_shaders.GetValue() && !blacklist_async_shaders;
     use_driver_cache = is_nvidia;
+    // Nvidia already caches programs internally, GLASM programs can't be retrieved as binaries
+    use_program_binary_cache = !use_driver_cache &&
+                               shader_backend != Settings::ShaderBackend::Glasm &&
+                               GLAD_GL_ARB_get_program_binary &&
+                               GetInteger<u32>(GL_NUM_PROGRAM_BINARY_FORMATS) > 0;
     supports_conditional_barriers = !is_intel;
 
     LOG_INFO(Render_OpenGL, "Renderer_VariableAOFFI: {}", has_variable_aoffi);
@@ -251,6 +257,8 @@ Device::Device(Core::Frontend::EmuWindow& emu_window) {
     LOG_INFO(Render_OpenGL, "Renderer_PreciseBug: {}", has_precise_bug);
     LOG_INFO(Render_OpenGL, "Renderer_BrokenTextureViewFormats: {}",
              has_broken_texture_view_formats);
+    LOG_INFO(Render_OpenGL, "Renderer_ParallelShaderCompile: {}", has_parallel_shader_compile);
+    LOG_INFO(Render_OpenGL, "Renderer_ProgramBinaryCache: {}", use_program_binary_cache);
     if (Settings::values.use_asynchronous_shaders.GetValue() && !use_asynchronous_shaders) {
         LOG_WARNING(Render_OpenGL, "Asynchronous shader compilation enabled but not supported");
     }
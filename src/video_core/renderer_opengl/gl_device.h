@@ -124,6 +124,14 @@ public:
         return use_driver_cache;
     }
 
+    bool UseProgramBinaryCache() const {
+        return use_program_binary_cache;
+    }
+
+    bool HasParallelShaderCompile() const {
+        return has_parallel_shader_compile;
+    }
+
     bool HasDepthBufferFloat() const {
         return has_depth_buffer_float;
     }
@@ -228,6 +236,8 @@ private:
     bool use_assembly_shaders{};
     bool use_asynchronous_shaders{};
     bool use_driver_cache{};
+    bool use_program_binary_cache{};
+    bool has_parallel_shader_compile{};
     bool has_depth_buffer_float{};
     bool has_geometry_shader_passthrough{};
     bool has_nv_gpu_shader_5{};
@@ -10,6 +10,7 @@
 #include "common/thread_worker.h"
 #include "shader_recompiler/shader_info.h"
 #include "video_core/renderer_opengl/gl_graphics_pipeline.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_shader_util.h"
 #include "video_core/renderer_opengl/gl_state_tracker.h"
@@ -171,14 +172,16 @@ ConfigureFuncPtr ConfigureFunc(const std::array<Shader::Info, 5>& infos, u32 ena
 
 GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_cache_,
                                    BufferCache& buffer_cache_, ProgramManager& program_manager_,
-                                   StateTracker& state_tracker_, ShaderWorker* thread_worker,
+                                   StateTracker& state_tracker_, ProgramBinaryCache& binary_cache_,
+                                   ShaderWorker* thread_worker,
                                    VideoCore::ShaderNotify* shader_notify,
                                    std::array<std::string, 5> sources,
                                    std::array<std::vector<u32>, 5> sources_spirv,
                                    const std::array<const Shader::Info*, 5>& infos,
                                    const GraphicsPipelineKey& key_, bool force_context_flush)
     : texture_cache{texture_cache_}, buffer_cache{buffer_cache_}, program_manager{program_manager_},
-      state_tracker{state_tracker_}, key{key_} {
+      state_tracker{state_tracker_}, binary_cache{binary_cache_}, key{key_},
+      poll_completion{device.HasParallelShaderCompile()} {
     if (shader_notify) {
         shader_notify->MarkShaderBuilding();
     }
@@ -234,11 +237,13 @@ GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_c
     auto func{[this, sources_ = std::move(sources), sources_spirv_ = std::move(sources_spirv),
                shader_notify, backend, in_parallel,
                force_context_flush](ShaderContext::Context*) mutable {
+        std::array<u64, 5> new_binary_keys{};
         for (size_t stage = 0; stage < 5; ++stage) {
             switch (backend) {
             case Settings::ShaderBackend::Glsl:
                 if (!sources_[stage].empty()) {
-                    source_programs[stage] = CreateProgram(sources_[stage], Stage(stage));
+                    source_programs[stage] = binary_cache.CreateProgram(
+                        sources_[stage], Stage(stage), new_binary_keys[stage]);
                 }
                 break;
             case Settings::ShaderBackend::Glasm:
@@ -249,18 +254,32 @@ GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_c
                 break;
             case Settings::ShaderBackend::SpirV:
                 if (!sources_spirv_[stage].empty()) {
-                    source_programs[stage] = CreateProgram(sources_spirv_[stage], Stage(stage));
+                    source_programs[stage] = binary_cache.CreateProgram(
+                        sources_spirv_[stage], Stage(stage), new_binary_keys[stage]);
                 }
                 break;
             }
         }
         if (force_context_flush || in_parallel) {
+            // Waiting for the link to retrieve the binaries is fine on a worker thread
+            for (size_t stage = 0; stage < 5; ++stage) {
+                if (new_binary_keys[stage] != 0) {
+                    binary_cache.Save(new_binary_keys[stage], source_programs[stage].handle);
+                }
+            }
             std::scoped_lock lock{built_mutex};
             built_fence.Create();
             // Flush this context to ensure compilation commands and fence are in the GPU pipe.
             glFlush();
             built_condvar.notify_one();
+        } else if (poll_completion) {
+            // The driver compiles in its own threads, IsBuilt polls for completion without
+            // blocking and the binaries are saved once the programs are linked
+            binary_keys = new_binary_keys;
+            built_fence.Create();
         } else {
+            binary_keys = new_binary_keys;
+            SaveProgramBinaries();
             is_built = true;
         }
         if (shader_notify) {
@@ -619,7 +638,10 @@ void GraphicsPipeline::WaitForBuild() {
         std::unique_lock lock{built_mutex};
         built_condvar.wait(lock, [this] { return built_fence.handle != 0; });
     }
-    ASSERT(glClientWaitSync(built_fence.handle, 0, GL_TIMEOUT_IGNORED) != GL_WAIT_FAILED);
+    // Fences created on the main context may not have been flushed yet
+    ASSERT(glClientWaitSync(built_fence.handle, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED) !=
+           GL_WAIT_FAILED);
+    SaveProgramBinaries();
     is_built = true;
 }
 
@@ -630,8 +652,33 @@ bool GraphicsPipeline::IsBuilt() noexcept {
     if (built_fence.handle == 0) {
         return false;
     }
-    is_built = built_fence.IsSignaled();
+    is_built = built_fence.IsSignaled() && AreProgramsLinked();
+    if (is_built) {
+        SaveProgramBinaries();
+    }
     return is_built;
 }
 
+bool GraphicsPipeline::AreProgramsLinked() const noexcept {
+    if (!poll_completion) {
+        return true;
+    }
+    return std::ranges::all_of(source_programs, [](const OGLProgram& program) {
+        if (program.handle == 0) {
+            return true;
+        }
+        GLint completion_status{};
+        glGetProgramiv(program.handle, GL_COMPLETION_STATUS_KHR, &completion_status);
+        return completion_status != GL_FALSE;
+    });
+}
+
+void GraphicsPipeline::SaveProgramBinaries() {
+    for (size_t stage = 0; stage < binary_keys.size(); ++stage) {
+        if (binary_keys[stage] != 0) {
+            binary_cache.Save(std::exchange(binary_keys[stage], 0), source_programs[stage].handle);
+        }
+    }
+}
+
 } // namespace OpenGL
@@ -25,6 +25,7 @@ struct Context;
 }
 
 class Device;
+class ProgramBinaryCache;
 class ProgramManager;
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
@@ -73,8 +74,8 @@ class GraphicsPipeline {
 public:
     explicit GraphicsPipeline(const Device& device, TextureCache& texture_cache_,
                               BufferCache& buffer_cache_, ProgramManager& program_manager_,
-                              StateTracker& state_tracker_, ShaderWorker* thread_worker,
-                              VideoCore::ShaderNotify* shader_notify,
+                              StateTracker& state_tracker_, ProgramBinaryCache& binary_cache_,
+                              ShaderWorker* thread_worker, VideoCore::ShaderNotify* shader_notify,
                               std::array<std::string, 5> sources,
                               std::array<std::vector<u32>, 5> sources_spirv,
                               const std::array<const Shader::Info*, 5>& infos,
@@ -126,12 +127,19 @@ private:
 
     void WaitForBuild();
 
+    /// Returns true when the driver has finished compiling and linking every program
+    [[nodiscard]] bool AreProgramsLinked() const noexcept;
+
+    /// Saves the binaries of the programs compiled on the main context
+    void SaveProgramBinaries();
+
     TextureCache& texture_cache;
     BufferCache& buffer_cache;
     Tegra::MemoryManager* gpu_memory;
     Tegra::Engines::Maxwell3D* maxwell3d;
     ProgramManager& program_manager;
     StateTracker& state_tracker;
+    ProgramBinaryCache& binary_cache;
     const GraphicsPipelineKey key;
 
     void (*configure_func)(GraphicsPipeline*, bool){};
@@ -161,6 +169,8 @@ private:
     std::condition_variable built_condvar;
     OGLSync built_fence{};
     bool is_built{false};
+    bool poll_completion{false};
+    std::array<u64, 5> binary_keys{};
 };
 
 } // namespace OpenGL
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <fstream>
+#include <string>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/renderer_opengl/gl_device.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
+#include "video_core/renderer_opengl/gl_shader_util.h"
+
+namespace OpenGL {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'g', 'l', 'p', 'b'};
+constexpr u32 CACHE_VERSION = 1;
+
+struct Header {
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    u32 padding;
+    u64 driver_key;
+
+    [[nodiscard]] bool operator==(const Header&) const = default;
+};
+static_assert(std::has_unique_object_representations_v<Header>);
+
+/// Binaries are only valid for the driver build that produced them
+u64 DriverKey() {
+    std::string driver;
+    for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        driver += reinterpret_cast<const char*>(glGetString(name));
+        driver += '\n';
+    }
+    return Common::CityHash64(driver.data(), driver.size());
+}
+
+void RemoveCacheFile(const std::filesystem::path& filename) {
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete program binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+} // Anonymous namespace
+
+ProgramBinaryCache::ProgramBinaryCache(const Device& device)
+    : enabled{device.UseProgramBinaryCache()} {
+    if (enabled) {
+        driver_key = DriverKey();
+    }
+}
+
+void ProgramBinaryCache::Load(const std::filesystem::path& filename_) try {
+    if (!enabled) {
+        return;
+    }
+    // Finish appending to the previous file before switching to another one
+    write_thread.WaitForRequests();
+    filename = filename_;
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{file.tellg()};
+    file.seekg(0, std::ios::beg);
+
+    const Header expected_header{MAGIC_NUMBER, CACHE_VERSION, 0, driver_key};
+    Header header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (header != expected_header) {
+        file.close();
+        LOG_INFO(Common_Filesystem, "Deleting program binary cache of a different driver");
+        RemoveCacheFile(filename);
+        return;
+    }
+    std::scoped_lock lock{mutex};
+    while (file.tellg() != end) {
+        u64 key{};
+        Binary binary{};
+        u32 size{};
+        file.read(reinterpret_cast<char*>(&key), sizeof(key))
+            .read(reinterpret_cast<char*>(&binary.format), sizeof(binary.format))
+            .read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (static_cast<std::streamoff>(size) > end - file.tellg()) {
+            // Sizes come from the file, a truncated or corrupt entry must not drive the allocation
+            file.close();
+            LOG_ERROR(Common_Filesystem, "Deleting corrupt program binary cache");
+            binaries.clear();
+            RemoveCacheFile(filename);
+            return;
+        }
+        binary.data.resize(size);
+        file.read(reinterpret_cast<char*>(binary.data.data()), size);
+        binaries.insert_or_assign(key, std::move(binary));
+    }
+    LOG_INFO(Common_Filesystem, "Loaded {} cached program binaries", binaries.size());
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    binaries.clear();
+    RemoveCacheFile(filename);
+}
+
+OGLProgram ProgramBinaryCache::CreateProgram(std::string_view code, GLenum stage,
+                                             u64& binary_key) {
+    return CreateCachedProgram(code, stage, binary_key);
+}
+
+OGLProgram ProgramBinaryCache::CreateProgram(std::span<const u32> code, GLenum stage,
+                                             u64& binary_key) {
+    return CreateCachedProgram(code, stage, binary_key);
+}
+
+template <typename Code>
+OGLProgram ProgramBinaryCache::CreateCachedProgram(Code code, GLenum stage, u64& binary_key) {
+    if (!enabled) {
+        return OpenGL::CreateProgram(code, stage);
+    }
+    const auto bytes{std::as_bytes(std::span(code))};
+    const u64 key{Common::CityHash64WithSeed(reinterpret_cast<const char*>(bytes.data()),
+                                             bytes.size(), stage)};
+    if (OGLProgram program{Restore(key)}; program.handle != 0) {
+        return program;
+    }
+    binary_key = key;
+    return OpenGL::CreateProgram(code, stage, true);
+}
+
+OGLProgram ProgramBinaryCache::Restore(u64 binary_key) {
+    const Binary* binary{};
+    {
+        std::scoped_lock lock{mutex};
+        const auto it{binaries.find(binary_key)};
+        if (it == binaries.end()) {
+            return {};
+        }
+        // Binaries are never erased, the reference stays valid after unlocking
+        binary = &it->second;
+    }
+    OGLProgram program;
+    program.handle = glCreateProgram();
+    glProgramParameteri(program.handle, GL_PROGRAM_SEPARABLE, GL_TRUE);
+    glProgramBinary(program.handle, binary->format, binary->data.data(),
+                    static_cast<GLsizei>(binary->data.size()));
+    GLint link_status{};
+    glGetProgramiv(program.handle, GL_LINK_STATUS, &link_status);
+    if (link_status == GL_FALSE) {
+        // The driver may reject binaries even when its version string didn't change
+        program.Release();
+    }
+    return program;
+}
+
+void ProgramBinaryCache::Save(u64 binary_key, GLuint program) {
+    GLint link_status{};
+    glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+    GLint length{};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (link_status == GL_FALSE || length <= 0) {
+        return;
+    }
+    Binary binary{.format = 0, .data = std::vector<u8>(static_cast<size_t>(length))};
+    glGetProgramBinary(program, length, nullptr, &binary.format, binary.data.data());
+
+    std::scoped_lock lock{mutex};
+    const auto [it, is_new] = binaries.try_emplace(binary_key, std::move(binary));
+    if (!is_new || filename.empty()) {
+        return;
+    }
+    // File I/O would stall the thread building programs, binaries are never erased so the saved
+    // one can be referenced from the write thread
+    write_thread.QueueWork([this, path = filename, binary_key, saved = &it->second] {
+        Write(path, binary_key, *saved);
+    });
+}
+
+void ProgramBinaryCache::Write(const std::filesystem::path& path, u64 binary_key,
+                               const Binary& binary) try {
+    std::ofstream file(path, std::ios::binary | std::ios::ate | std::ios::app);
+    file.exceptions(std::ifstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open program binary cache file {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    if (file.tellp() == 0) {
+        const Header header{MAGIC_NUMBER, CACHE_VERSION, 0, driver_key};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    const u32 size{static_cast<u32>(binary.data.size())};
+    file.write(reinterpret_cast<const char*>(&binary_key), sizeof(binary_key))
+        .write(reinterpret_cast<const char*>(&binary.format), sizeof(binary.format))
+        .write(reinterpret_cast<const char*>(&size), sizeof(size))
+        .write(reinterpret_cast<const char*>(binary.data.data()), size);
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    RemoveCacheFile(path);
+}
+
+} // namespace OpenGL
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "video_core/renderer_opengl/gl_resource_manager.h"
+
+namespace OpenGL {
+
+class Device;
+
+/// Disk cache of linked program binaries retrieved with glGetProgramBinary.
+/// Programs are keyed by the driver and the emitted code of the stage, so identical stages of
+/// different pipelines share a binary and only the first one pays for compilation.
+class ProgramBinaryCache {
+public:
+    explicit ProgramBinaryCache(const Device& device);
+
+    /// Loads the binaries of a cache file, the file is discarded when it was written by a
+    /// different driver
+    void Load(const std::filesystem::path& filename);
+
+    /// Creates a separable program, restoring it from a cached binary when possible.
+    /// binary_key is set when the program has been compiled and its binary has to be saved once
+    /// it is linked, it is left untouched otherwise.
+    [[nodiscard]] OGLProgram CreateProgram(std::string_view code, GLenum stage, u64& binary_key);
+
+    [[nodiscard]] OGLProgram CreateProgram(std::span<const u32> code, GLenum stage,
+                                           u64& binary_key);
+
+    /// Retrieves the binary of a linked program and queues appending it to the cache file
+    void Save(u64 binary_key, GLuint program);
+
+private:
+    struct Binary {
+        GLenum format;
+        std::vector<u8> data;
+    };
+
+    template <typename Code>
+    OGLProgram CreateCachedProgram(Code code, GLenum stage, u64& binary_key);
+
+    /// Returns a program created from the cached binary, or an empty program on a miss
+    [[nodiscard]] OGLProgram Restore(u64 binary_key);
+
+    /// Appends a binary to the cache file, runs on the write thread
+    void Write(const std::filesystem::path& path, u64 binary_key, const Binary& binary);
+
+    bool enabled{};
+    u64 driver_key{};
+    std::filesystem::path filename;
+    std::unordered_map<u64, Binary> binaries;
+    std::mutex mutex;
+    Common::ThreadWorker write_thread{1, "GLProgramBinaryWriter"};
+};
+
+} // namespace OpenGL
@@ -688,6 +688,7 @@ void RasterizerOpenGL::TickFrame() {
     num_queued_commands = 0;
 
     fence_manager.TickFrame();
+    staging_buffer_pool.TickFrame();
     {
         std::scoped_lock lock{texture_cache.mutex};
         texture_cache.TickFrame();
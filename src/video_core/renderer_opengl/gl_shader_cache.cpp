@@ -4,6 +4,7 @@
 #include <atomic>
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -177,7 +178,7 @@ ShaderCache::ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
       texture_cache{texture_cache_}, buffer_cache{buffer_cache_}, program_manager{program_manager_},
       state_tracker{state_tracker_}, shader_notify{shader_notify_},
       use_asynchronous_shaders{device.UseAsynchronousShaders()},
-      strict_context_required{device.StrictContextRequired()},
+      strict_context_required{device.StrictContextRequired()}, binary_cache{device},
       profile{
           .supported_spirv = 0x00010000,
 
@@ -247,7 +248,11 @@ ShaderCache::ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
           .min_ssbo_alignment = static_cast<u32>(device.GetShaderStorageBufferAlignment()),
           .support_geometry_shader_passthrough = device.HasGeometryShaderPassthrough(),
           .support_conditional_barrier = device.SupportsConditionalBarriers(),
+          .enable_global_optimizations = Settings::values.shader_global_optimizations.GetValue(),
       } {
+    if (device.HasParallelShaderCompile()) {
+        glMaxShaderCompilerThreadsKHR(std::numeric_limits<GLuint>::max());
+    }
     if (use_asynchronous_shaders) {
         workers = CreateWorkers();
     }
@@ -267,13 +272,14 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         return;
     }
     shader_cache_filename = base_dir / "opengl.bin";
+    binary_cache.Load(base_dir / "opengl_binaries.bin");
 
     if (!workers && !strict_context_required) {
         workers = CreateWorkers();
     }
     std::optional<Context> strict_context;
     if (strict_context_required) {
-        strict_context.emplace(emu_window);
+        strict_context.emplace(emu_window, device.HasParallelShaderCompile());
     }
 
     struct {
@@ -431,8 +437,10 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline() {
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
 
     main_pools.ReleaseContents();
+    // Drivers compiling in parallel on their own don't need a shared context to overlap the build
+    const bool use_shader_workers{use_asynchronous_shaders && !device.HasParallelShaderCompile()};
     auto pipeline{CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(),
-                                         use_asynchronous_shaders)};
+                                         use_shader_workers)};
     if (!pipeline || shader_cache_filename.empty()) {
         return pipeline;
     }
@@ -477,7 +485,8 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
         ++env_index;
 
         const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
-        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
+        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0, cfg_cache,
+                                       key.unique_hashes[index]);
 
         if (Settings::values.dump_shaders) {
             env.Dump(hash, key.unique_hashes[index]);
@@ -544,8 +553,9 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     }
     auto* const thread_worker{use_shader_workers ? workers.get() : nullptr};
     return std::make_unique<GraphicsPipeline>(device, texture_cache, buffer_cache, program_manager,
-                                              state_tracker, thread_worker, &shader_notify, sources,
-                                              sources_spirv, infos, key, force_context_flush);
+                                              state_tracker, binary_cache, thread_worker,
+                                              &shader_notify, sources, sources_spirv, infos, key,
+                                              force_context_flush);
 
 } catch (Shader::Exception& exception) {
     LOG_ERROR(Render_OpenGL, "{}", exception.what());
@@ -575,7 +585,8 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     auto hash = key.Hash();
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
 
-    Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
+    Shader::Maxwell::Flow::CFG cfg{
+        env, pools.flow_block, env.StartAddress(), false, cfg_cache, key.unique_hash};
 
     if (Settings::values.dump_shaders) {
         env.Dump(hash, key.unique_hash);
@@ -601,7 +612,8 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     }
 
     return std::make_unique<ComputePipeline>(device, texture_cache, buffer_cache, program_manager,
-                                             program.info, code, code_spirv, force_context_flush);
+                                             binary_cache, program.info, code, code_spirv,
+                                             force_context_flush);
 } catch (Shader::Exception& exception) {
     LOG_ERROR(Render_OpenGL, "{}", exception.what());
     return nullptr;
@@ -610,7 +622,10 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
 std::unique_ptr<ShaderWorker> ShaderCache::CreateWorkers() const {
     return std::make_unique<ShaderWorker>(std::max(std::thread::hardware_concurrency(), 2U) - 1,
                                           "GlShaderBuilder",
-                                          [this] { return Context{emu_window}; });
+                                          [this] {
+                                              return Context{emu_window,
+                                                             device.HasParallelShaderCompile()};
+                                          });
 }
 
 } // namespace OpenGL
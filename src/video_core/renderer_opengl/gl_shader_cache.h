@@ -8,10 +8,12 @@
 
 #include "common/common_types.h"
 #include "common/thread_worker.h"
+#include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/profile.h"
 #include "video_core/renderer_opengl/gl_compute_pipeline.h"
 #include "video_core/renderer_opengl/gl_graphics_pipeline.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
 #include "video_core/renderer_opengl/gl_shader_context.h"
 #include "video_core/shader_cache.h"
 
@@ -73,6 +75,7 @@ private:
     VideoCore::ShaderNotify& shader_notify;
     const bool use_asynchronous_shaders;
     const bool strict_context_required;
+    ProgramBinaryCache binary_cache;
 
     GraphicsPipelineKey graphics_key{};
     GraphicsPipeline* current_pipeline{};
@@ -83,6 +86,7 @@ private:
 
     Shader::Profile profile;
     Shader::HostTranslateInfo host_info;
+    Shader::Maxwell::Flow::CFGCache cfg_cache;
 
     std::filesystem::path shader_cache_filename;
     std::unique_ptr<ShaderWorker> workers;
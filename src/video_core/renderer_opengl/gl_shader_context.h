@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <limits>
+
+#include <glad/glad.h>
+
 #include "core/frontend/emu_window.h"
 #include "core/frontend/graphics_context.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
@@ -22,8 +26,13 @@ struct ShaderPools {
 };
 
 struct Context {
-    explicit Context(Core::Frontend::EmuWindow& emu_window)
-        : gl_context{emu_window.CreateSharedContext()}, scoped{*gl_context} {}
+    explicit Context(Core::Frontend::EmuWindow& emu_window, bool parallel_shader_compile = false)
+        : gl_context{emu_window.CreateSharedContext()}, scoped{*gl_context} {
+        if (parallel_shader_compile) {
+            // The thread limit is per context, let the driver pick its own maximum
+            glMaxShaderCompilerThreadsKHR(std::numeric_limits<GLuint>::max());
+        }
+    }
 
     std::unique_ptr<Core::Frontend::GraphicsContext> gl_context;
     Core::Frontend::GraphicsContext::Scoped scoped;
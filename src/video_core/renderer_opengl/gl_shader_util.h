@@ -12,9 +12,10 @@
 
 namespace OpenGL {
 
-OGLProgram CreateProgram(std::string_view code, GLenum stage);
+/// Creates a separable program, retrievable programs can be saved with glGetProgramBinary
+OGLProgram CreateProgram(std::string_view code, GLenum stage, bool retrievable = false);
 
-OGLProgram CreateProgram(std::span<const u32> code, GLenum stage);
+OGLProgram CreateProgram(std::span<const u32> code, GLenum stage, bool retrievable = false);
 
 OGLAssemblyProgram CompileProgram(std::string_view code, GLenum target);
 
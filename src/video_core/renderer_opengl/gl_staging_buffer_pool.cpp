@@ -10,6 +10,7 @@
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/bit_util.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "video_core/renderer_opengl/gl_staging_buffer_pool.h"
 
@@ -145,7 +146,74 @@ std::pair<std::span<u8>, size_t> StreamBuffer::Request(size_t size) noexcept {
     return {std::span(mapped_pointer + offset, size), offset};
 }
 
+StagingBufferRing::StagingBufferRing(GLenum storage_flags, GLenum map_flags) {
+    buffer.Create();
+    glObjectLabel(GL_BUFFER, buffer.handle, -1, "Staging Ring");
+    glNamedBufferStorage(buffer.handle, RING_SIZE, nullptr, storage_flags | GL_MAP_PERSISTENT_BIT);
+    mapped_pointer = static_cast<u8*>(
+        glMapNamedBufferRange(buffer.handle, 0, RING_SIZE, map_flags | GL_MAP_PERSISTENT_BIT));
+}
+
+std::optional<StagingBufferMap> StagingBufferRing::Request(size_t size) {
+    if (size == 0 || size > MAX_REQUEST_SIZE) {
+        return std::nullopt;
+    }
+    // Uploads in the regions left behind since the last request have already been issued
+    for (size_t region = Region(used_iterator), region_end = Region(iterator); region < region_end;
+         ++region) {
+        fences[region].Create();
+    }
+    used_iterator = iterator;
+
+    const bool wraps = iterator + size > RING_SIZE;
+    const size_t offset = wraps ? 0 : iterator;
+    const size_t last_region = Region(offset + size - 1);
+    const size_t first_region = wraps ? 0 : std::min(free_region, last_region + 1);
+    if (!AreRegionsIdle(first_region, last_region)) {
+        return std::nullopt;
+    }
+    if (wraps) {
+        for (size_t region = Region(used_iterator); region < NUM_REGIONS; ++region) {
+            fences[region].Create();
+        }
+        used_iterator = 0;
+        free_region = 0;
+    }
+    for (size_t region = first_region; region <= last_region; ++region) {
+        fences[region].Release();
+    }
+    free_region = std::max(free_region, last_region + 1);
+    iterator = Common::AlignUp(offset + size, MAX_ALIGNMENT);
+    return StagingBufferMap{
+        .mapped_span = std::span(mapped_pointer + offset, size),
+        .offset = offset,
+        .sync = nullptr,
+        .buffer = buffer.handle,
+        .index = 0,
+    };
+}
+
+bool StagingBufferRing::AreRegionsIdle(size_t first_region, size_t last_region) {
+    // Fences are signaled in order, checking the last fenced region is enough
+    for (size_t region = last_region + 1; region-- > first_region;) {
+        if (fences[region].handle != 0) {
+            return fences[region].IsSignaled();
+        }
+    }
+    return true;
+}
+
 StagingBufferMap StagingBufferPool::RequestUploadBuffer(size_t size) {
+    if (!upload_ring) {
+        upload_ring.emplace(UPLOAD_STORAGE_FLAGS, UPLOAD_MAP_FLAGS);
+    }
+    if (std::optional<StagingBufferMap> map = upload_ring->Request(size)) {
+        ++ring_uploads;
+        ring_upload_bytes += size;
+        return std::move(*map);
+    }
+    ++fallback_uploads;
+    fallback_upload_bytes += size;
     return upload_buffers.RequestMap(size, true);
 }
 
@@ -157,4 +225,17 @@ void StagingBufferPool::FreeDeferredStagingBuffer(StagingBufferMap& buffer) {
     download_buffers.FreeDeferredStagingBuffer(buffer.index);
 }
 
+void StagingBufferPool::TickFrame() {
+    if (ring_uploads != 0 || fallback_uploads != 0) {
+        LOG_DEBUG(Render_OpenGL,
+                  "Staging uploads: {} from the ring ({} bytes), {} from dedicated buffers "
+                  "({} bytes)",
+                  ring_uploads, ring_upload_bytes, fallback_uploads, fallback_upload_bytes);
+    }
+    ring_uploads = 0;
+    ring_upload_bytes = 0;
+    fallback_uploads = 0;
+    fallback_upload_bytes = 0;
+}
+
 } // namespace OpenGL
@@ -86,6 +86,40 @@ private:
     std::array<OGLSync, NUM_SYNCS> fences;
 };
 
+/// Persistently mapped ring shared by buffer and texture uploads.
+/// The ring is split in regions fenced once the uploads leave them. Reclaiming a region never
+/// waits for the GPU, requests that would have to wait fail so the caller can fall back.
+class StagingBufferRing {
+    static constexpr size_t RING_SIZE = 64_MiB;
+    static constexpr size_t NUM_REGIONS = 64;
+    static constexpr size_t REGION_SIZE = RING_SIZE / NUM_REGIONS;
+    static constexpr size_t MAX_ALIGNMENT = 256;
+    static_assert(RING_SIZE % NUM_REGIONS == 0);
+    static_assert(REGION_SIZE % MAX_ALIGNMENT == 0);
+
+public:
+    static constexpr size_t MAX_REQUEST_SIZE = RING_SIZE / 4;
+
+    explicit StagingBufferRing(GLenum storage_flags, GLenum map_flags);
+
+    [[nodiscard]] std::optional<StagingBufferMap> Request(size_t size);
+
+private:
+    [[nodiscard]] static size_t Region(size_t offset) noexcept {
+        return offset / REGION_SIZE;
+    }
+
+    /// Returns true when the GPU no longer uses the given regions, never waits
+    [[nodiscard]] bool AreRegionsIdle(size_t first_region, size_t last_region);
+
+    size_t iterator = 0;
+    size_t used_iterator = 0;
+    size_t free_region = NUM_REGIONS;
+    u8* mapped_pointer = nullptr;
+    OGLBuffer buffer;
+    std::array<OGLSync, NUM_REGIONS> fences;
+};
+
 class StagingBufferPool {
 public:
     StagingBufferPool() = default;
@@ -95,9 +129,20 @@ public:
     StagingBufferMap RequestDownloadBuffer(size_t size, bool deferred = false);
     void FreeDeferredStagingBuffer(StagingBufferMap& buffer);
 
+    void TickFrame();
+
 private:
-    StagingBuffers upload_buffers{GL_MAP_WRITE_BIT, GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT};
+    static constexpr GLenum UPLOAD_STORAGE_FLAGS = GL_MAP_WRITE_BIT;
+    static constexpr GLenum UPLOAD_MAP_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+
+    std::optional<StagingBufferRing> upload_ring;
+    StagingBuffers upload_buffers{UPLOAD_STORAGE_FLAGS, UPLOAD_MAP_FLAGS};
     StagingBuffers download_buffers{GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT, GL_MAP_READ_BIT};
+
+    u64 ring_uploads = 0;
+    u64 ring_upload_bytes = 0;
+    u64 fallback_uploads = 0;
+    u64 fallback_upload_bytes = 0;
 };
 
 } // namespace OpenGL
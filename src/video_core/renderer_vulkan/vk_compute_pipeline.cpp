@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <span>
 #include <vector>
 
 #include <boost/container/small_vector.hpp>
@@ -44,11 +45,15 @@ ComputePipeline::ComputePipeline(const Device& device_, vk::PipelineCache& pipel
         DescriptorLayoutBuilder builder{device};
         builder.Add(info, VK_SHADER_STAGE_COMPUTE_BIT);
 
-        descriptor_set_layout = builder.CreateDescriptorSetLayout(false);
+        uses_push_descriptor = builder.CanUsePushDescriptor();
+        num_descriptors = builder.NumDescriptors();
+        descriptor_set_layout = builder.CreateDescriptorSetLayout(uses_push_descriptor);
         pipeline_layout = builder.CreatePipelineLayout(*descriptor_set_layout);
-        descriptor_update_template =
-            builder.CreateTemplate(*descriptor_set_layout, *pipeline_layout, false);
-        descriptor_allocator = descriptor_pool.Allocator(*descriptor_set_layout, info);
+        descriptor_update_template = builder.CreateTemplate(
+            *descriptor_set_layout, *pipeline_layout, uses_push_descriptor);
+        if (!uses_push_descriptor) {
+            descriptor_allocator = descriptor_pool.Allocator(*descriptor_set_layout, info);
+        }
         const VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT subgroup_size_ci{
             .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO_EXT,
             .pNext = nullptr,
@@ -206,8 +211,8 @@ void ComputePipeline::Configure(Tegra::Engines::KeplerCompute& kepler_compute,
     }
     const void* const descriptor_data{guest_descriptor_queue.UpdateData()};
     const bool is_rescaling = !info.texture_descriptors.empty() || !info.image_descriptors.empty();
-    scheduler.Record([this, descriptor_data, is_rescaling,
-                      rescaling_data = rescaling.Data()](vk::CommandBuffer cmdbuf) {
+    scheduler.Record([this, descriptor_data, is_rescaling, rescaling_data = rescaling.Data(),
+                      tick = scheduler.CurrentTick()](vk::CommandBuffer cmdbuf) {
         cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, *pipeline);
         if (!descriptor_set_layout) {
             return;
@@ -217,9 +222,24 @@ void ComputePipeline::Configure(Tegra::Engines::KeplerCompute& kepler_compute,
                                  RESCALING_LAYOUT_WORDS_OFFSET, sizeof(rescaling_data),
                                  rescaling_data.data());
         }
-        const VkDescriptorSet descriptor_set{descriptor_allocator.Commit()};
-        const vk::Device& dev{device.GetLogical()};
-        dev.UpdateDescriptorSet(descriptor_set, *descriptor_update_template, descriptor_data);
+        if (uses_push_descriptor) {
+            cmdbuf.PushDescriptorSetWithTemplateKHR(*descriptor_update_template, *pipeline_layout,
+                                                    0, descriptor_data);
+            guest_descriptor_queue.CountPushed(num_descriptors);
+            return;
+        }
+        const std::span<const u8> payload{static_cast<const u8*>(descriptor_data),
+                                          num_descriptors * sizeof(DescriptorUpdateEntry)};
+        VkDescriptorSet descriptor_set{descriptor_allocator.FindReusable(tick, payload)};
+        if (descriptor_set) {
+            guest_descriptor_queue.CountReused(num_descriptors);
+        } else {
+            descriptor_set = descriptor_allocator.Commit();
+            const vk::Device& dev{device.GetLogical()};
+            dev.UpdateDescriptorSet(descriptor_set, *descriptor_update_template, descriptor_data);
+            descriptor_allocator.SetLastWrite(tick, descriptor_set, payload);
+            guest_descriptor_queue.CountUpdated(num_descriptors);
+        }
         cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, *pipeline_layout, 0,
                                   descriptor_set, nullptr);
     });
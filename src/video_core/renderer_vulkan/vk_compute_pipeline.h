@@ -63,6 +63,8 @@ private:
     std::condition_variable build_condvar;
     std::mutex build_mutex;
     std::atomic_bool is_built{false};
+    bool uses_push_descriptor{false};
+    u32 num_descriptors{};
 };
 
 } // namespace Vulkan
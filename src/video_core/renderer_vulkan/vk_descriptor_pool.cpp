@@ -94,6 +94,21 @@ VkDescriptorSet DescriptorAllocator::Commit() {
     return sets[index / SETS_GROW_RATE][index % SETS_GROW_RATE];
 }
 
+VkDescriptorSet DescriptorAllocator::FindReusable(u64 tick, std::span<const u8> payload) const {
+    // Sets committed for a command buffer are not recycled until it has finished executing
+    if (!last_set || last_tick != tick || !std::ranges::equal(last_payload, payload)) {
+        return VK_NULL_HANDLE;
+    }
+    return last_set;
+}
+
+void DescriptorAllocator::SetLastWrite(u64 tick, VkDescriptorSet set,
+                                       std::span<const u8> payload) {
+    last_set = set;
+    last_tick = tick;
+    last_payload.assign(payload.begin(), payload.end());
+}
+
 void DescriptorAllocator::Allocate(size_t begin, size_t end) {
     sets.push_back(AllocateDescriptors(end - begin));
 }
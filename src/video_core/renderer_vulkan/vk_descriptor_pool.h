@@ -45,6 +45,13 @@ public:
 
     VkDescriptorSet Commit();
 
+    /// Returns the last committed set if it was written with the same payload for the command
+    /// buffer of the given tick, or a null handle when a new set has to be committed
+    [[nodiscard]] VkDescriptorSet FindReusable(u64 tick, std::span<const u8> payload) const;
+
+    /// Remembers the payload written to a committed set
+    void SetLastWrite(u64 tick, VkDescriptorSet set, std::span<const u8> payload);
+
 private:
     explicit DescriptorAllocator(const Device& device_, MasterSemaphore& master_semaphore_,
                                  DescriptorBank& bank_, VkDescriptorSetLayout layout_);
@@ -58,6 +65,10 @@ private:
     VkDescriptorSetLayout layout{};
 
     std::vector<vk::DescriptorSets> sets;
+
+    VkDescriptorSet last_set{};
+    u64 last_tick{};
+    std::vector<u8> last_payload;
 };
 
 class DescriptorPool {
@@ -14,6 +14,7 @@
 #include "video_core/renderer_vulkan/pipeline_statistics.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/renderer_vulkan/vk_pipeline_library.h"
 #include "video_core/renderer_vulkan/vk_render_pass_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
@@ -240,11 +241,14 @@ GraphicsPipeline::GraphicsPipeline(
     const Device& device_, DescriptorPool& descriptor_pool,
     GuestDescriptorQueue& guest_descriptor_queue_, Common::ThreadWorker* worker_thread,
     PipelineStatistics* pipeline_statistics, RenderPassCache& render_pass_cache,
-    const GraphicsPipelineCacheKey& key_, std::array<vk::ShaderModule, NUM_STAGES> stages,
+    PipelineLibraryCache* library_cache_, const GraphicsPipelineCacheKey& key_,
+    std::array<vk::ShaderModule, NUM_STAGES> stages, u64 spirv_hash_,
     const std::array<const Shader::Info*, NUM_STAGES>& infos)
     : key{key_}, device{device_}, texture_cache{texture_cache_}, buffer_cache{buffer_cache_},
       pipeline_cache(pipeline_cache_), scheduler{scheduler_},
-      guest_descriptor_queue{guest_descriptor_queue_}, spv_modules{std::move(stages)} {
+      guest_descriptor_queue{guest_descriptor_queue_},
+      library_cache{worker_thread ? library_cache_ : nullptr}, spv_modules{std::move(stages)},
+      spirv_hash{spirv_hash_} {
     if (shader_notify) {
         shader_notify->MarkShaderBuilding();
     }
@@ -258,9 +262,11 @@ GraphicsPipeline::GraphicsPipeline(
         std::ranges::copy(info->constant_buffer_used_sizes, uniform_buffer_sizes[stage].begin());
         num_textures += Shader::NumDescriptors(info->texture_descriptors);
     }
-    auto func{[this, shader_notify, &render_pass_cache, &descriptor_pool, pipeline_statistics] {
+    auto func{[this, shader_notify, &render_pass_cache, &descriptor_pool, pipeline_statistics,
+                worker_thread] {
         DescriptorLayoutBuilder builder{MakeBuilder(device, stage_infos)};
         uses_push_descriptor = builder.CanUsePushDescriptor();
+        num_descriptors = builder.NumDescriptors();
         descriptor_set_layout = builder.CreateDescriptorSetLayout(uses_push_descriptor);
         if (!uses_push_descriptor) {
             descriptor_allocator = descriptor_pool.Allocator(*descriptor_set_layout, stage_infos);
@@ -272,9 +278,21 @@ GraphicsPipeline::GraphicsPipeline(
 
         const VkRenderPass render_pass{render_pass_cache.Get(MakeRenderPassKey(key.state))};
         Validate();
-        MakePipeline(render_pass);
-        if (pipeline_statistics) {
-            pipeline_statistics->Collect(*pipeline);
+        if (library_cache) {
+            // Draws use the fast-linked pipeline until the optimized one is swapped in
+            fast_linked_pipeline = MakePipeline(render_pass, true);
+            worker_thread->QueueWork([this, render_pass, pipeline_statistics] {
+                pipeline = MakePipeline(render_pass, false);
+                if (pipeline_statistics) {
+                    pipeline_statistics->Collect(*pipeline);
+                }
+                is_optimized.store(true, std::memory_order::release);
+            });
+        } else {
+            pipeline = MakePipeline(render_pass, false);
+            if (pipeline_statistics) {
+                pipeline_statistics->Collect(*pipeline);
+            }
         }
 
         std::scoped_lock lock{build_mutex};
@@ -501,14 +519,25 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
     }
     const bool is_rescaling{texture_cache.IsRescaling()};
     const bool update_rescaling{scheduler.UpdateRescaling(is_rescaling)};
-    const bool bind_pipeline{scheduler.UpdateGraphicsPipeline(this)};
+    // Rebind when the optimized pipeline replaces the fast-linked one
+    const bool use_optimized{!library_cache || is_optimized.load(std::memory_order::acquire)};
+    const bool bind_pipeline{scheduler.UpdateGraphicsPipeline(this) ||
+                             (use_optimized && !bound_optimized)};
+    if (bind_pipeline) {
+        bound_optimized = use_optimized;
+    }
     const void* const descriptor_data{guest_descriptor_queue.UpdateData()};
-    scheduler.Record([this, descriptor_data, bind_pipeline, rescaling_data = rescaling.Data(),
-                      is_rescaling, update_rescaling,
+    scheduler.Record([this, descriptor_data, bind_pipeline, use_optimized,
+                      draws_optimized = bound_optimized, rescaling_data = rescaling.Data(),
+                      is_rescaling, update_rescaling, tick = scheduler.CurrentTick(),
                       uses_render_area = render_area.uses_render_area,
                       render_area_data = render_area.words](vk::CommandBuffer cmdbuf) {
         if (bind_pipeline) {
-            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline);
+            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                use_optimized ? *pipeline : *fast_linked_pipeline);
+        }
+        if (library_cache) {
+            library_cache->CountDraw(draws_optimized);
         }
         cmdbuf.PushConstants(*pipeline_layout, VK_SHADER_STAGE_ALL_GRAPHICS,
                              RESCALING_LAYOUT_WORDS_OFFSET, sizeof(rescaling_data),
@@ -531,17 +560,27 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
         if (uses_push_descriptor) {
             cmdbuf.PushDescriptorSetWithTemplateKHR(*descriptor_update_template, *pipeline_layout,
                                                     0, descriptor_data);
+            guest_descriptor_queue.CountPushed(num_descriptors);
+            return;
+        }
+        const std::span<const u8> payload{static_cast<const u8*>(descriptor_data),
+                                          num_descriptors * sizeof(DescriptorUpdateEntry)};
+        VkDescriptorSet descriptor_set{descriptor_allocator.FindReusable(tick, payload)};
+        if (descriptor_set) {
+            guest_descriptor_queue.CountReused(num_descriptors);
         } else {
-            const VkDescriptorSet descriptor_set{descriptor_allocator.Commit()};
+            descriptor_set = descriptor_allocator.Commit();
             const vk::Device& dev{device.GetLogical()};
             dev.UpdateDescriptorSet(descriptor_set, *descriptor_update_template, descriptor_data);
-            cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline_layout, 0,
-                                      descriptor_set, nullptr);
+            descriptor_allocator.SetLastWrite(tick, descriptor_set, payload);
+            guest_descriptor_queue.CountUpdated(num_descriptors);
         }
+        cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline_layout, 0,
+                                  descriptor_set, nullptr);
     });
 }
 
-void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
+vk::Pipeline GraphicsPipeline::MakePipeline(VkRenderPass render_pass, bool fast_link) const {
     FixedPipelineState::DynamicState dynamic{};
     if (!key.state.extended_dynamic_state) {
         dynamic = key.state.dynamic_state;
@@ -875,32 +914,34 @@ void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
         */
     }
     VkPipelineCreateFlags flags{};
-    if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
+    if (device.IsKhrPipelineExecutablePropertiesEnabled() && !fast_link) {
         flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
     }
-    pipeline = device.GetLogical().CreateGraphicsPipeline(
-        {
-            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = flags,
-            .stageCount = static_cast<u32>(shader_stages.size()),
-            .pStages = shader_stages.data(),
-            .pVertexInputState = &vertex_input_ci,
-            .pInputAssemblyState = &input_assembly_ci,
-            .pTessellationState = &tessellation_ci,
-            .pViewportState = &viewport_ci,
-            .pRasterizationState = &rasterization_ci,
-            .pMultisampleState = &multisample_ci,
-            .pDepthStencilState = &depth_stencil_ci,
-            .pColorBlendState = &color_blend_ci,
-            .pDynamicState = &dynamic_state_ci,
-            .layout = *pipeline_layout,
-            .renderPass = render_pass,
-            .subpass = 0,
-            .basePipelineHandle = nullptr,
-            .basePipelineIndex = 0,
-        },
-        *pipeline_cache);
+    const VkGraphicsPipelineCreateInfo pipeline_ci{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = flags,
+        .stageCount = static_cast<u32>(shader_stages.size()),
+        .pStages = shader_stages.data(),
+        .pVertexInputState = &vertex_input_ci,
+        .pInputAssemblyState = &input_assembly_ci,
+        .pTessellationState = &tessellation_ci,
+        .pViewportState = &viewport_ci,
+        .pRasterizationState = &rasterization_ci,
+        .pMultisampleState = &multisample_ci,
+        .pDepthStencilState = &depth_stencil_ci,
+        .pColorBlendState = &color_blend_ci,
+        .pDynamicState = &dynamic_state_ci,
+        .layout = *pipeline_layout,
+        .renderPass = render_pass,
+        .subpass = 0,
+        .basePipelineHandle = nullptr,
+        .basePipelineIndex = 0,
+    };
+    if (fast_link) {
+        return library_cache->Link(pipeline_ci, spirv_hash, *pipeline_cache);
+    }
+    return device.GetLogical().CreateGraphicsPipeline(pipeline_ci, *pipeline_cache);
 }
 
 void GraphicsPipeline::Validate() {
@@ -59,6 +59,7 @@ struct hash<Vulkan::GraphicsPipelineCacheKey> {
 namespace Vulkan {
 
 class Device;
+class PipelineLibraryCache;
 class PipelineStatistics;
 class RenderPassCache;
 class RescalingPushConstant;
@@ -75,7 +76,8 @@ public:
         const Device& device, DescriptorPool& descriptor_pool,
         GuestDescriptorQueue& guest_descriptor_queue, Common::ThreadWorker* worker_thread,
         PipelineStatistics* pipeline_statistics, RenderPassCache& render_pass_cache,
-        const GraphicsPipelineCacheKey& key, std::array<vk::ShaderModule, NUM_STAGES> stages,
+        PipelineLibraryCache* library_cache, const GraphicsPipelineCacheKey& key,
+        std::array<vk::ShaderModule, NUM_STAGES> stages, u64 spirv_hash,
         const std::array<const Shader::Info*, NUM_STAGES>& infos);
 
     GraphicsPipeline& operator=(GraphicsPipeline&&) noexcept = delete;
@@ -120,7 +122,8 @@ private:
     void ConfigureDraw(const RescalingPushConstant& rescaling,
                        const RenderAreaPushConstant& render_are);
 
-    void MakePipeline(VkRenderPass render_pass);
+    /// Creates the optimized monolithic pipeline, or fast-links it from pipeline libraries
+    [[nodiscard]] vk::Pipeline MakePipeline(VkRenderPass render_pass, bool fast_link) const;
 
     void Validate();
 
@@ -133,6 +136,7 @@ private:
     vk::PipelineCache& pipeline_cache;
     Scheduler& scheduler;
     GuestDescriptorQueue& guest_descriptor_queue;
+    PipelineLibraryCache* library_cache;
 
     void (*configure_func)(GraphicsPipeline*, bool){};
 
@@ -140,6 +144,7 @@ private:
     std::vector<GraphicsPipeline*> transitions;
 
     std::array<vk::ShaderModule, NUM_STAGES> spv_modules;
+    u64 spirv_hash{};
 
     std::array<Shader::Info, NUM_STAGES> stage_infos;
     std::array<u32, 5> enabled_uniform_buffer_masks{};
@@ -151,11 +156,15 @@ private:
     vk::PipelineLayout pipeline_layout;
     vk::DescriptorUpdateTemplate descriptor_update_template;
     vk::Pipeline pipeline;
+    vk::Pipeline fast_linked_pipeline;
 
     std::condition_variable build_condvar;
     std::mutex build_mutex;
     std::atomic_bool is_built{false};
+    std::atomic_bool is_optimized{false};
+    bool bound_optimized{false};
     bool uses_push_descriptor{false};
+    u32 num_descriptors{};
 };
 
 } // namespace Vulkan
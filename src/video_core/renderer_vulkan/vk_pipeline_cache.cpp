@@ -17,6 +17,7 @@
 #include "core/core.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
 #include "shader_recompiler/environment.h"
+#include "shader_recompiler/frontend/ir/serialization.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/frontend/maxwell/translate_program.h"
 #include "shader_recompiler/program_header.h"
@@ -45,9 +46,10 @@ MICROPROFILE_DECLARE(Vulkan_PipelineCache);
 namespace {
 using Shader::Backend::SPIRV::EmitSPIRV;
 using Shader::Maxwell::ConvertLegacyToGeneric;
+using Shader::Maxwell::FinalizeProgram;
 using Shader::Maxwell::GenerateGeometryPassthrough;
 using Shader::Maxwell::MergeDualVertexPrograms;
-using Shader::Maxwell::TranslateProgram;
+using Shader::Maxwell::TranslateProgramBase;
 using VideoCommon::ComputeEnvironment;
 using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
@@ -390,6 +392,7 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
         .min_ssbo_alignment = static_cast<u32>(device.GetStorageBufferAlignment()),
         .support_geometry_shader_passthrough = device.IsNvGeometryShaderPassthroughSupported(),
         .support_conditional_barrier = device.SupportsConditionalBarriers(),
+        .enable_global_optimizations = Settings::values.shader_global_optimizations.GetValue(),
     };
 
     if (device.GetMaxVertexInputAttributes() < Maxwell::NumVertexAttributes) {
@@ -409,6 +412,9 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
         .has_extended_dynamic_state_3_enables = device.IsExtExtendedDynamicState3EnablesSupported(),
         .has_dynamic_vertex_input = device.IsExtVertexInputDynamicStateSupported(),
     };
+    if (device.IsExtGraphicsPipelineLibrarySupported()) {
+        library_cache = std::make_unique<PipelineLibraryCache>(device);
+    }
 }
 
 PipelineCache::~PipelineCache() {
@@ -418,6 +424,12 @@ PipelineCache::~PipelineCache() {
     }
 }
 
+void PipelineCache::TickFrame() {
+    if (library_cache) {
+        library_cache->TickFrame();
+    }
+}
+
 GraphicsPipeline* PipelineCache::CurrentGraphicsPipeline() {
     MICROPROFILE_SCOPE(Vulkan_PipelineCache);
 
@@ -471,6 +483,7 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         return;
     }
     pipeline_cache_filename = base_dir / "vulkan.bin";
+    ir_cache.Load(base_dir / "vulkan_ir.bin", CACHE_VERSION, host_info);
 
     if (use_vulkan_pipeline_cache) {
         vulkan_pipeline_cache_filename = base_dir / "vulkan_pipelines.bin";
@@ -555,6 +568,10 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     lock.unlock();
 
     workers.WaitForRequests(stop_loading);
+    if (!stop_loading.stop_requested()) {
+        // Pipelines created from now on are not in the pipeline cache, nor their programs
+        ir_cache.ReleaseLoaded();
+    }
 
     if (use_vulkan_pipeline_cache) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
@@ -634,14 +651,16 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
         ++env_index;
 
         const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
-        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
+        const u32 stage{static_cast<u32>(index)};
         if (!uses_vertex_a || index != 1) {
             // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
+            programs[index] = TranslateStage(pools, env, hash, key.unique_hashes[index], stage,
+                                             cfg_offset, index == 0);
         } else {
             // VertexB path when VertexA is present.
             auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+            auto program_vb{TranslateStage(pools, env, hash, key.unique_hashes[index], stage,
+                                           cfg_offset, false)};
             programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
         }
 
@@ -655,6 +674,7 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     }
     std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
     std::array<vk::ShaderModule, Maxwell::MaxShaderStage> modules;
+    u64 spirv_hash{};
 
     const Shader::IR::Program* previous_stage{};
     Shader::Backend::Bindings binding;
@@ -676,6 +696,8 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
         const std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
         device.SaveShader(code);
         modules[stage_index] = BuildShader(device, code);
+        spirv_hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(code.data()),
+                                                code.size() * sizeof(u32), spirv_hash);
         if (device.HasDebuggingToolAttached()) {
             const std::string name{fmt::format("Shader {:016x}", key.unique_hashes[index])};
             modules[stage_index].SetObjectNameEXT(name.c_str());
@@ -685,8 +707,8 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
     return std::make_unique<GraphicsPipeline>(
         scheduler, buffer_cache, texture_cache, vulkan_pipeline_cache, &shader_notify, device,
-        descriptor_pool, guest_descriptor_queue, thread_worker, statistics, render_pass_cache, key,
-        std::move(modules), infos);
+        descriptor_pool, guest_descriptor_queue, thread_worker, statistics, render_pass_cache,
+        library_cache.get(), key, std::move(modules), spirv_hash, infos);
 
 } catch (const Shader::Exception& exception) {
     auto hash = key.Hash();
@@ -759,14 +781,12 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
 
     LOG_INFO(Render_Vulkan, "0x{:016x}", hash);
 
-    Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
-
     // Dump it before error.
     if (Settings::values.dump_shaders) {
         env.Dump(hash, key.unique_hash);
     }
 
-    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+    auto program{TranslateStage(pools, env, hash, key.unique_hash, 0, env.StartAddress(), false)};
     const std::vector<u32> code{EmitSPIRV(profile, program)};
     device.SaveShader(code);
     vk::ShaderModule spv_module{BuildShader(device, code)};
@@ -784,6 +804,31 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     return nullptr;
 }
 
+Shader::IR::Program PipelineCache::TranslateStage(ShaderPools& pools, Shader::Environment& env,
+                                                  u64 pipeline_hash, u64 shader_hash, u32 stage,
+                                                  u32 cfg_offset, bool exits_to_dispatcher) {
+    if (const std::vector<u8>* const cached{ir_cache.Find(pipeline_hash, stage)}) {
+        auto program{Shader::IR::DeserializeProgram(pools.inst, pools.block, *cached)};
+        if (program) {
+            FinalizeProgram(env, *program, host_info);
+            return std::move(*program);
+        }
+        LOG_WARNING(Render_Vulkan, "Invalid cached program for 0x{:016x}, translating it",
+                    pipeline_hash);
+    }
+    Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, exits_to_dispatcher,
+                                   cfg_cache, shader_hash);
+    auto program{TranslateProgramBase(pools.inst, pools.block, env, cfg, host_info)};
+    if (ir_cache.IsEnabled()) {
+        serialization_thread.QueueWork(
+            [this, pipeline_hash, stage, data = Shader::IR::SerializeProgram(program)] {
+                ir_cache.Save(pipeline_hash, stage, data);
+            });
+    }
+    FinalizeProgram(env, program, host_info);
+    return program;
+}
+
 void PipelineCache::SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                                  const vk::PipelineCache& pipeline_cache,
                                                  u32 cache_version) try {
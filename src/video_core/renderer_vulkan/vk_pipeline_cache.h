@@ -25,8 +25,10 @@
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_compute_pipeline.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/renderer_vulkan/vk_pipeline_library.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/shader_cache.h"
+#include "video_core/shader_ir_cache.h"
 
 namespace Core {
 class System;
@@ -110,6 +112,9 @@ public:
 
     [[nodiscard]] ComputePipeline* CurrentComputePipeline();
 
+    /// Reports the pipeline library statistics of the frame
+    void TickFrame();
+
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback);
 
@@ -134,6 +139,11 @@ private:
                                                            PipelineStatistics* statistics,
                                                            bool build_in_parallel);
 
+    /// Translates a shader stage, reusing the program cached on disk when there is one
+    Shader::IR::Program TranslateStage(ShaderPools& pools, Shader::Environment& env,
+                                       u64 pipeline_hash, u64 shader_hash, u32 stage,
+                                       u32 cfg_offset, bool exits_to_dispatcher);
+
     void SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                       const vk::PipelineCache& pipeline_cache, u32 cache_version);
 
@@ -154,6 +164,9 @@ private:
     GraphicsPipelineCacheKey graphics_key{};
     GraphicsPipeline* current_pipeline{};
 
+    /// Declared before the pipelines, linked pipelines never outlive their libraries
+    std::unique_ptr<PipelineLibraryCache> library_cache;
+
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<ComputePipeline>> compute_cache;
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>> graphics_cache;
 
@@ -163,6 +176,8 @@ private:
     Shader::HostTranslateInfo host_info;
 
     std::filesystem::path pipeline_cache_filename;
+    VideoCommon::ShaderIRCache ir_cache;
+    Shader::Maxwell::Flow::CFGCache cfg_cache;
 
     std::filesystem::path vulkan_pipeline_cache_filename;
     vk::PipelineCache vulkan_pipeline_cache;
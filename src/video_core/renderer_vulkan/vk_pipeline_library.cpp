@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "common/cityhash.h"
+#include "common/logging/log.h"
+#include "video_core/renderer_vulkan/vk_pipeline_library.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+namespace {
+using LibraryKey = std::vector<u32>;
+
+constexpr VkGraphicsPipelineLibraryFlagsEXT VERTEX_INPUT_LIBRARY =
+    VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+constexpr VkGraphicsPipelineLibraryFlagsEXT SHADER_LIBRARY =
+    VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT |
+    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+constexpr VkGraphicsPipelineLibraryFlagsEXT FRAGMENT_OUTPUT_LIBRARY =
+    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+
+template <typename T>
+void Append(LibraryKey& key, const T& value) {
+    static_assert(std::has_unique_object_representations_v<T>);
+    static_assert(sizeof(T) % sizeof(u32) == 0);
+    const size_t offset{key.size()};
+    key.resize(offset + sizeof(T) / sizeof(u32));
+    std::memcpy(key.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+void Append(LibraryKey& key, std::span<const T> values) {
+    Append(key, static_cast<u32>(values.size()));
+    for (const T& value : values) {
+        Append(key, value);
+    }
+}
+
+template <typename T>
+const T* FindNext(const void* next, VkStructureType type) {
+    for (auto* it = static_cast<const VkBaseInStructure*>(next); it != nullptr; it = it->pNext) {
+        if (it->sType == type) {
+            return reinterpret_cast<const T*>(it);
+        }
+    }
+    return nullptr;
+}
+
+void AppendMultisample(LibraryKey& key, const VkPipelineMultisampleStateCreateInfo& multisample) {
+    Append(key, multisample.rasterizationSamples);
+    Append(key, multisample.sampleShadingEnable);
+    Append(key, multisample.alphaToCoverageEnable);
+    Append(key, multisample.alphaToOneEnable);
+}
+
+void AppendDynamicStates(LibraryKey& key, const VkGraphicsPipelineCreateInfo& ci) {
+    const VkPipelineDynamicStateCreateInfo& dynamic{*ci.pDynamicState};
+    Append(key, std::span(dynamic.pDynamicStates, dynamic.dynamicStateCount));
+}
+
+void AppendRenderPass(LibraryKey& key, const VkGraphicsPipelineCreateInfo& ci) {
+    Append(key, ci.renderPass);
+    Append(key, ci.subpass);
+}
+
+LibraryKey VertexInputKey(const VkGraphicsPipelineCreateInfo& ci) {
+    LibraryKey key;
+    Append(key, VERTEX_INPUT_LIBRARY);
+    const VkPipelineVertexInputStateCreateInfo& vertex_input{*ci.pVertexInputState};
+    Append(key, std::span(vertex_input.pVertexBindingDescriptions,
+                          vertex_input.vertexBindingDescriptionCount));
+    Append(key, std::span(vertex_input.pVertexAttributeDescriptions,
+                          vertex_input.vertexAttributeDescriptionCount));
+    std::span<const VkVertexInputBindingDivisorDescriptionEXT> divisors;
+    if (const auto* const divisor_ci{FindNext<VkPipelineVertexInputDivisorStateCreateInfoEXT>(
+            vertex_input.pNext,
+            VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_DIVISOR_STATE_CREATE_INFO_EXT)}) {
+        divisors = std::span(divisor_ci->pVertexBindingDivisors,
+                             divisor_ci->vertexBindingDivisorCount);
+    }
+    Append(key, divisors);
+    Append(key, ci.pInputAssemblyState->topology);
+    Append(key, ci.pInputAssemblyState->primitiveRestartEnable);
+    AppendDynamicStates(key, ci);
+    return key;
+}
+
+LibraryKey ShaderKey(const VkGraphicsPipelineCreateInfo& ci, u64 spirv_hash) {
+    LibraryKey key;
+    Append(key, SHADER_LIBRARY);
+    Append(key, spirv_hash);
+    for (const VkPipelineShaderStageCreateInfo& stage : std::span(ci.pStages, ci.stageCount)) {
+        Append(key, stage.stage);
+    }
+    Append(key, ci.pTessellationState->patchControlPoints);
+
+    const VkPipelineViewportStateCreateInfo& viewport{*ci.pViewportState};
+    Append(key, viewport.viewportCount);
+    Append(key, viewport.scissorCount);
+    std::span<const VkViewportSwizzleNV> swizzles;
+    if (const auto* const swizzle_ci{FindNext<VkPipelineViewportSwizzleStateCreateInfoNV>(
+            viewport.pNext, VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_SWIZZLE_STATE_CREATE_INFO_NV)}) {
+        swizzles = std::span(swizzle_ci->pViewportSwizzles, swizzle_ci->viewportCount);
+    }
+    Append(key, swizzles);
+    const auto* const ndc_ci{FindNext<VkPipelineViewportDepthClipControlCreateInfoEXT>(
+        viewport.pNext, VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_DEPTH_CLIP_CONTROL_CREATE_INFO_EXT)};
+    Append(key, ndc_ci ? ndc_ci->negativeOneToOne : VK_FALSE);
+
+    // Floating-point parameters are either dynamic or the same for every pipeline
+    const VkPipelineRasterizationStateCreateInfo& rasterization{*ci.pRasterizationState};
+    Append(key, rasterization.depthClampEnable);
+    Append(key, rasterization.rasterizerDiscardEnable);
+    Append(key, rasterization.polygonMode);
+    Append(key, rasterization.cullMode);
+    Append(key, rasterization.frontFace);
+    Append(key, rasterization.depthBiasEnable);
+    const auto* const line_ci{FindNext<VkPipelineRasterizationLineStateCreateInfoEXT>(
+        rasterization.pNext, VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_LINE_STATE_CREATE_INFO_EXT)};
+    Append(key, line_ci ? line_ci->lineRasterizationMode : VK_LINE_RASTERIZATION_MODE_DEFAULT_EXT);
+    const auto* const conservative_ci{
+        FindNext<VkPipelineRasterizationConservativeStateCreateInfoEXT>(
+            rasterization.pNext,
+            VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_CONSERVATIVE_STATE_CREATE_INFO_EXT)};
+    Append(key, conservative_ci ? conservative_ci->conservativeRasterizationMode
+                                : VK_CONSERVATIVE_RASTERIZATION_MODE_DISABLED_EXT);
+    const auto* const provoking_ci{
+        FindNext<VkPipelineRasterizationProvokingVertexStateCreateInfoEXT>(
+            rasterization.pNext,
+            VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_PROVOKING_VERTEX_STATE_CREATE_INFO_EXT)};
+    Append(key, provoking_ci ? provoking_ci->provokingVertexMode
+                             : VK_PROVOKING_VERTEX_MODE_FIRST_VERTEX_EXT);
+
+    AppendMultisample(key, *ci.pMultisampleState);
+    const VkPipelineDepthStencilStateCreateInfo& depth_stencil{*ci.pDepthStencilState};
+    Append(key, depth_stencil.depthTestEnable);
+    Append(key, depth_stencil.depthWriteEnable);
+    Append(key, depth_stencil.depthCompareOp);
+    Append(key, depth_stencil.depthBoundsTestEnable);
+    Append(key, depth_stencil.stencilTestEnable);
+    Append(key, depth_stencil.front);
+    Append(key, depth_stencil.back);
+    AppendRenderPass(key, ci);
+    AppendDynamicStates(key, ci);
+    return key;
+}
+
+LibraryKey FragmentOutputKey(const VkGraphicsPipelineCreateInfo& ci) {
+    LibraryKey key;
+    Append(key, FRAGMENT_OUTPUT_LIBRARY);
+    const VkPipelineColorBlendStateCreateInfo& color_blend{*ci.pColorBlendState};
+    Append(key, color_blend.logicOpEnable);
+    Append(key, color_blend.logicOp);
+    Append(key, std::span(color_blend.pAttachments, color_blend.attachmentCount));
+    AppendMultisample(key, *ci.pMultisampleState);
+    AppendRenderPass(key, ci);
+    AppendDynamicStates(key, ci);
+    return key;
+}
+
+VkGraphicsPipelineCreateInfo VertexInputInterface(const VkGraphicsPipelineCreateInfo& ci) {
+    return {
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .stageCount = 0,
+        .pStages = nullptr,
+        .pVertexInputState = ci.pVertexInputState,
+        .pInputAssemblyState = ci.pInputAssemblyState,
+        .pTessellationState = nullptr,
+        .pViewportState = nullptr,
+        .pRasterizationState = nullptr,
+        .pMultisampleState = nullptr,
+        .pDepthStencilState = nullptr,
+        .pColorBlendState = nullptr,
+        .pDynamicState = ci.pDynamicState,
+        .layout = VK_NULL_HANDLE,
+        .renderPass = VK_NULL_HANDLE,
+        .subpass = 0,
+        .basePipelineHandle = VK_NULL_HANDLE,
+        .basePipelineIndex = 0,
+    };
+}
+
+VkGraphicsPipelineCreateInfo ShaderState(const VkGraphicsPipelineCreateInfo& ci) {
+    return {
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .stageCount = ci.stageCount,
+        .pStages = ci.pStages,
+        .pVertexInputState = nullptr,
+        .pInputAssemblyState = nullptr,
+        .pTessellationState = ci.pTessellationState,
+        .pViewportState = ci.pViewportState,
+        .pRasterizationState = ci.pRasterizationState,
+        .pMultisampleState = ci.pMultisampleState,
+        .pDepthStencilState = ci.pDepthStencilState,
+        .pColorBlendState = nullptr,
+        .pDynamicState = ci.pDynamicState,
+        .layout = ci.layout,
+        .renderPass = ci.renderPass,
+        .subpass = ci.subpass,
+        .basePipelineHandle = VK_NULL_HANDLE,
+        .basePipelineIndex = 0,
+    };
+}
+
+VkGraphicsPipelineCreateInfo FragmentOutputInterface(const VkGraphicsPipelineCreateInfo& ci) {
+    return {
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .stageCount = 0,
+        .pStages = nullptr,
+        .pVertexInputState = nullptr,
+        .pInputAssemblyState = nullptr,
+        .pTessellationState = nullptr,
+        .pViewportState = nullptr,
+        .pRasterizationState = nullptr,
+        .pMultisampleState = ci.pMultisampleState,
+        .pDepthStencilState = nullptr,
+        .pColorBlendState = ci.pColorBlendState,
+        .pDynamicState = ci.pDynamicState,
+        .layout = VK_NULL_HANDLE,
+        .renderPass = ci.renderPass,
+        .subpass = ci.subpass,
+        .basePipelineHandle = VK_NULL_HANDLE,
+        .basePipelineIndex = 0,
+    };
+}
+} // Anonymous namespace
+
+PipelineLibraryCache::PipelineLibraryCache(const Device& device_) : device{device_} {}
+
+PipelineLibraryCache::~PipelineLibraryCache() = default;
+
+vk::Pipeline PipelineLibraryCache::Link(const VkGraphicsPipelineCreateInfo& ci, u64 spirv_hash,
+                                        VkPipelineCache pipeline_cache) {
+    // Pipeline layouts are built from the shader info, identical SPIR-V yields identically
+    // defined layouts and the shader library can be linked with any of them
+    const std::array<VkPipeline, 3> parts{
+        Library(VertexInputKey(ci), VERTEX_INPUT_LIBRARY, VertexInputInterface(ci),
+                pipeline_cache),
+        Library(ShaderKey(ci, spirv_hash), SHADER_LIBRARY, ShaderState(ci), pipeline_cache),
+        Library(FragmentOutputKey(ci), FRAGMENT_OUTPUT_LIBRARY, FragmentOutputInterface(ci),
+                pipeline_cache),
+    };
+    const VkPipelineLibraryCreateInfoKHR library_ci{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+        .pNext = nullptr,
+        .libraryCount = static_cast<u32>(parts.size()),
+        .pLibraries = parts.data(),
+    };
+    // Linking without VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT is the fast path
+    return device.GetLogical().CreateGraphicsPipeline(
+        {
+            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+            .pNext = &library_ci,
+            .flags = 0,
+            .stageCount = 0,
+            .pStages = nullptr,
+            .pVertexInputState = nullptr,
+            .pInputAssemblyState = nullptr,
+            .pTessellationState = nullptr,
+            .pViewportState = nullptr,
+            .pRasterizationState = nullptr,
+            .pMultisampleState = nullptr,
+            .pDepthStencilState = nullptr,
+            .pColorBlendState = nullptr,
+            .pDynamicState = nullptr,
+            .layout = ci.layout,
+            .renderPass = ci.renderPass,
+            .subpass = ci.subpass,
+            .basePipelineHandle = VK_NULL_HANDLE,
+            .basePipelineIndex = 0,
+        },
+        pipeline_cache);
+}
+
+void PipelineLibraryCache::TickFrame() {
+    const u64 fast_linked = fast_linked_draws.exchange(0, std::memory_order_relaxed);
+    const u64 optimized = optimized_draws.exchange(0, std::memory_order_relaxed);
+    const u64 built = built_libraries.exchange(0, std::memory_order_relaxed);
+    if (fast_linked != 0 || built != 0) {
+        LOG_DEBUG(Render_Vulkan,
+                  "Pipeline libraries: {} fast-linked draws, {} optimized draws, {} libraries "
+                  "built",
+                  fast_linked, optimized, built);
+    }
+}
+
+size_t PipelineLibraryCache::LibraryKeyHash::operator()(const LibraryKey& key) const noexcept {
+    return static_cast<size_t>(
+        Common::CityHash64(reinterpret_cast<const char*>(key.data()), key.size() * sizeof(u32)));
+}
+
+VkPipeline PipelineLibraryCache::Library(LibraryKey key, VkGraphicsPipelineLibraryFlagsEXT flags,
+                                         const VkGraphicsPipelineCreateInfo& part_ci,
+                                         VkPipelineCache pipeline_cache) {
+    {
+        std::scoped_lock lock{mutex};
+        const auto it{libraries.find(key)};
+        if (it != libraries.end()) {
+            return *it->second;
+        }
+    }
+    // Compile outside of the lock, other workers keep linking against the cached libraries
+    const VkGraphicsPipelineLibraryCreateInfoEXT library_ci{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+        .pNext = nullptr,
+        .flags = flags,
+    };
+    VkGraphicsPipelineCreateInfo library_pipeline_ci{part_ci};
+    library_pipeline_ci.pNext = &library_ci;
+    library_pipeline_ci.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+    vk::Pipeline library{
+        device.GetLogical().CreateGraphicsPipeline(library_pipeline_ci, pipeline_cache)};
+    built_libraries.fetch_add(1, std::memory_order_relaxed);
+
+    // Another worker may have built the same library meanwhile, keep the first one
+    std::scoped_lock lock{mutex};
+    return *libraries.try_emplace(std::move(key), std::move(library)).first->second;
+}
+
+} // namespace Vulkan
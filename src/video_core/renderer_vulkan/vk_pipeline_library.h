@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+
+/// Caches VK_EXT_graphics_pipeline_library parts shared between graphics pipelines.
+/// Shader libraries are keyed by their SPIR-V and the state they are compiled with, so pipelines
+/// that only differ in vertex input or blending link against the already compiled shaders.
+class PipelineLibraryCache {
+public:
+    explicit PipelineLibraryCache(const Device& device);
+    ~PipelineLibraryCache();
+
+    PipelineLibraryCache& operator=(const PipelineLibraryCache&) = delete;
+    PipelineLibraryCache(const PipelineLibraryCache&) = delete;
+
+    /// Fast-links the pipeline described by a complete create info, building missing libraries.
+    /// spirv_hash identifies the code of the shader modules referenced by the create info.
+    [[nodiscard]] vk::Pipeline Link(const VkGraphicsPipelineCreateInfo& ci, u64 spirv_hash,
+                                    VkPipelineCache pipeline_cache);
+
+    /// Counts a draw recorded with a fast-linked or an optimized pipeline, reported once per frame
+    void CountDraw(bool is_optimized) noexcept {
+        auto& counter{is_optimized ? optimized_draws : fast_linked_draws};
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TickFrame();
+
+private:
+    using LibraryKey = std::vector<u32>;
+
+    struct LibraryKeyHash {
+        [[nodiscard]] size_t operator()(const LibraryKey& key) const noexcept;
+    };
+
+    /// Returns the library with the given key, creating it from the partial create info if needed
+    VkPipeline Library(LibraryKey key, VkGraphicsPipelineLibraryFlagsEXT flags,
+                       const VkGraphicsPipelineCreateInfo& part_ci, VkPipelineCache pipeline_cache);
+
+    const Device& device;
+    std::unordered_map<LibraryKey, vk::Pipeline, LibraryKeyHash> libraries;
+    std::mutex mutex;
+
+    std::atomic<u64> fast_linked_draws{};
+    std::atomic<u64> optimized_draws{};
+    std::atomic<u64> built_libraries{};
+};
+
+} // namespace Vulkan
@@ -59,26 +59,9 @@ public:
         VideoCommon::BankBase::Reset();
         const auto& dev = device.GetLogical();
         dev.ResetQueryPool(*query_pool, 0, BANK_SIZE);
-        host_results.fill(0ULL);
         next_bank = 0;
     }
 
-    void Sync(size_t start, size_t size) {
-        const auto& dev = device.GetLogical();
-        const VkResult query_result = dev.GetQueryResults(
-            *query_pool, static_cast<u32>(start), static_cast<u32>(size), sizeof(u64) * size,
-            &host_results[start], sizeof(u64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
-        switch (query_result) {
-        case VK_SUCCESS:
-            return;
-        case VK_ERROR_DEVICE_LOST:
-            device.ReportLoss();
-            [[fallthrough]];
-        default:
-            throw vk::Exception(query_result);
-        }
-    }
-
     VkQueryPool GetInnerPool() {
         return *query_pool;
     }
@@ -87,17 +70,12 @@ public:
         return index;
     }
 
-    const std::array<u64, BANK_SIZE>& GetResults() const {
-        return host_results;
-    }
-
     size_t next_bank;
 
 private:
     const Device& device;
     const size_t index;
     vk::QueryPool query_pool;
-    std::array<u64, BANK_SIZE> host_results;
 };
 
 using BaseStreamer = VideoCommon::SimpleStreamer<VideoCommon::HostQueryBase>;
@@ -115,10 +93,11 @@ public:
     explicit SamplesStreamer(size_t id_, QueryCacheRuntime& runtime_,
                              VideoCore::RasterizerInterface* rasterizer_, const Device& device_,
                              Scheduler& scheduler_, const MemoryAllocator& memory_allocator_,
+                             StagingBufferPool& staging_pool_,
                              ComputePassDescriptorQueue& compute_pass_descriptor_queue,
                              DescriptorPool& descriptor_pool)
         : BaseStreamer(id_), runtime{runtime_}, rasterizer{rasterizer_}, device{device_},
-          scheduler{scheduler_}, memory_allocator{memory_allocator_} {
+          scheduler{scheduler_}, memory_allocator{memory_allocator_}, staging_pool{staging_pool_} {
         current_bank = nullptr;
         current_query = nullptr;
         amend_value = 0;
@@ -352,34 +331,81 @@ public:
     void PushUnsyncedQueries() override {
         PauseCounter();
         current_bank->Close();
-        {
-            std::scoped_lock lk(flush_guard);
-            pending_flush_sets.emplace_back(std::move(pending_flush_queries));
+
+        // Copy the results of every bank range in a single batch at the submit boundary, so
+        // flushing the queries only reads host visible memory once the fence is signaled.
+        FlushSet flush_set;
+        size_t total_slots = 0;
+        ApplyBanksWideOp<true>(pending_flush_queries,
+                               [&total_slots](SamplesQueryBank*, size_t, size_t amount) {
+                                   total_slots += amount;
+                               });
+        flush_set.staging_ref = staging_pool.Request(total_slots * SamplesQueryBank::QUERY_SIZE,
+                                                     MemoryUsage::Download, true);
+        size_t base_offset = flush_set.staging_ref.offset;
+        scheduler.RequestOutsideRenderPassOperationContext();
+        ApplyBanksWideOp<true>(pending_flush_queries, [&](SamplesQueryBank* bank, size_t start,
+                                                          size_t amount) {
+            scheduler.Record([query_pool = bank->GetInnerPool(), start, amount, base_offset,
+                              buffer = flush_set.staging_ref.buffer](vk::CommandBuffer cmdbuf) {
+                cmdbuf.CopyQueryPoolResults(query_pool, static_cast<u32>(start),
+                                            static_cast<u32>(amount), buffer, base_offset,
+                                            SamplesQueryBank::QUERY_SIZE,
+                                            VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_64_BIT);
+            });
+            flush_set.bank_offsets.emplace(bank->GetIndex(), std::make_pair(start, base_offset));
+            base_offset += amount * SamplesQueryBank::QUERY_SIZE;
+        });
+        static constexpr VkMemoryBarrier READ_BARRIER{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+        };
+        scheduler.Record([](vk::CommandBuffer cmdbuf) {
+            cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                                   READ_BARRIER);
+        });
+        flush_set.queries = std::move(pending_flush_queries);
+        pending_flush_queries.clear();
+
+        std::scoped_lock lk(flush_guard);
+        for (auto& staging_ref : free_queue) {
+            staging_pool.FreeDeferred(staging_ref);
         }
+        free_queue.clear();
+        pending_flush_sets.emplace_back(std::move(flush_set));
     }
 
     void PopUnsyncedQueries() override {
-        std::vector<size_t> current_flush_queries;
+        FlushSet flush_set;
         {
             std::scoped_lock lk(flush_guard);
-            current_flush_queries = std::move(pending_flush_sets.front());
+            flush_set = std::move(pending_flush_sets.front());
             pending_flush_sets.pop_front();
         }
-        ApplyBanksWideOp<false>(
-            current_flush_queries,
-            [](SamplesQueryBank* bank, size_t start, size_t amount) { bank->Sync(start, amount); });
-        for (auto q : current_flush_queries) {
+        const u8* const results = flush_set.staging_ref.mapped_span.data();
+        const size_t results_base = flush_set.staging_ref.offset;
+        for (auto q : flush_set.queries) {
             auto* query = GetQuery(q);
             u64 total = 0;
-            ApplyBankOp(query, [&total](SamplesQueryBank* bank, size_t start, size_t amount) {
-                const auto& results = bank->GetResults();
+            ApplyBankOp(query, [&](SamplesQueryBank* bank, size_t start, size_t amount) {
+                const auto [bank_start, bank_offset] = flush_set.bank_offsets.at(bank->GetIndex());
+                size_t offset = bank_offset - results_base +
+                                (start - bank_start) * SamplesQueryBank::QUERY_SIZE;
                 for (size_t i = 0; i < amount; i++) {
-                    total += results[start + i];
+                    u64 result;
+                    std::memcpy(&result, results + offset, sizeof(result));
+                    total += result;
+                    offset += SamplesQueryBank::QUERY_SIZE;
                 }
             });
             query->value = total;
             query->flags |= VideoCommon::QueryFlagBits::IsFinalValueSynced;
         }
+
+        std::scoped_lock lk(flush_guard);
+        free_queue.emplace_back(flush_set.staging_ref);
     }
 
 private:
@@ -552,11 +578,19 @@ private:
         return buffers.size() - 1;
     }
 
+    struct FlushSet {
+        std::vector<size_t> queries;
+        StagingBufferRef staging_ref;
+        // Bank index to the first slot copied and its offset in the staging buffer
+        std::unordered_map<size_t, std::pair<size_t, size_t>> bank_offsets;
+    };
+
     QueryCacheRuntime& runtime;
     VideoCore::RasterizerInterface* rasterizer;
     const Device& device;
     Scheduler& scheduler;
     const MemoryAllocator& memory_allocator;
+    StagingBufferPool& staging_pool;
     VideoCommon::BankPool<SamplesQueryBank> bank_pool;
     std::deque<vk::Buffer> buffers;
     std::array<size_t, 32> resolve_table{};
@@ -570,7 +604,8 @@ private:
 
     // flush levels
     std::vector<size_t> pending_flush_queries;
-    std::deque<std::vector<size_t>> pending_flush_sets;
+    std::deque<FlushSet> pending_flush_sets;
+    std::vector<StagingBufferRef> free_queue;
 
     // State Machine
     size_t current_bank_slot;
@@ -1166,8 +1201,8 @@ struct QueryCacheRuntimeImpl {
           memory_allocator{memory_allocator_}, scheduler{scheduler_}, staging_pool{staging_pool_},
           guest_streamer(0, runtime),
           sample_streamer(static_cast<size_t>(QueryType::ZPassPixelCount64), runtime, rasterizer,
-                          device, scheduler, memory_allocator, compute_pass_descriptor_queue,
-                          descriptor_pool),
+                          device, scheduler, memory_allocator, staging_pool,
+                          compute_pass_descriptor_queue, descriptor_pool),
           tfb_streamer(static_cast<size_t>(QueryType::StreamingByteCount), runtime, device,
                        scheduler, memory_allocator, staging_pool),
           primitives_succeeded_streamer(
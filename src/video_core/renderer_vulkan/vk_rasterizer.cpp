@@ -766,6 +766,7 @@ void RasterizerVulkan::TickFrame() {
     compute_pass_descriptor_queue.TickFrame();
     fence_manager.TickFrame();
     staging_pool.TickFrame();
+    pipeline_cache.TickFrame();
     {
         std::scoped_lock lock{texture_cache.mutex};
         texture_cache.TickFrame();
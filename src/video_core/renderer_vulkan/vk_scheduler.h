@@ -29,6 +29,7 @@ class Device;
 class Framebuffer;
 class GraphicsPipeline;
 class StateTracker;
+class TransferQueue;
 
 struct QueryCacheParams;
 
@@ -122,6 +123,11 @@ public:
         return *master_semaphore;
     }
 
+    /// Returns the dedicated transfer queue, or null when uploads are recorded inline.
+    [[nodiscard]] TransferQueue* GetTransferQueue() const noexcept {
+        return transfer_queue.get();
+    }
+
     std::mutex submit_mutex;
 
 private:
@@ -234,6 +240,7 @@ private:
 
     std::unique_ptr<MasterSemaphore> master_semaphore;
     std::unique_ptr<CommandPool> command_pool;
+    std::unique_ptr<TransferQueue> transfer_queue;
 
     VideoCommon::QueryCacheBase<QueryCacheParams>* query_cache = nullptr;
 
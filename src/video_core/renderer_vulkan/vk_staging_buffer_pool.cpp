@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <utility>
 #include <vector>
 
@@ -12,6 +14,7 @@
 #include "common/bit_util.h"
 #include "common/common_types.h"
 #include "common/literals.h"
+#include "common/logging/log.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/vulkan_common/vulkan_device.h"
@@ -26,6 +29,35 @@ using namespace Common::Literals;
 constexpr VkDeviceSize MAX_ALIGNMENT = 256;
 // Stream buffer size in bytes
 constexpr VkDeviceSize MAX_STREAM_BUFFER_SIZE = 128_MiB;
+// Size in bytes of each staging ring buffer
+constexpr size_t RING_BUFFER_SIZE = 32_MiB;
+// Maximum number of staging ring buffers
+constexpr size_t MAX_RING_BUFFERS = 4;
+// Larger uploads use dedicated staging buffers instead of stalling the rings
+constexpr size_t MAX_RING_ALLOCATION_SIZE = RING_BUFFER_SIZE / 4;
+
+VkBufferUsageFlags StagingBufferUsage(const Device& device) {
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                               VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                               VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    if (device.IsExtTransformFeedbackSupported()) {
+        usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
+    }
+    return usage;
+}
+
+/// Staging buffers can be read by the dedicated transfer queue as well as the graphics queue
+void ShareWithTransferQueue(const Device& device, VkBufferCreateInfo& buffer_ci,
+                            std::array<u32, 2>& queue_families) {
+    if (!device.HasTransferQueue()) {
+        return;
+    }
+    queue_families = {device.GetGraphicsFamily(), device.GetTransferFamily()};
+    buffer_ci.sharingMode = VK_SHARING_MODE_CONCURRENT;
+    buffer_ci.queueFamilyIndexCount = static_cast<u32>(queue_families.size());
+    buffer_ci.pQueueFamilyIndices = queue_families.data();
+}
 
 size_t GetStreamBufferSize(const Device& device) {
     VkDeviceSize size{0};
@@ -65,6 +97,8 @@ StagingBufferPool::StagingBufferPool(const Device& device_, MemoryAllocator& mem
     if (device.IsExtTransformFeedbackSupported()) {
         stream_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
     }
+    std::array<u32, 2> queue_families;
+    ShareWithTransferQueue(device, stream_ci, queue_families);
     stream_buffer = memory_allocator.CreateBuffer(stream_ci, MemoryUsage::Stream);
     if (device.HasDebuggingToolAttached()) {
         stream_buffer.SetObjectNameEXT("Stream Buffer");
@@ -76,10 +110,14 @@ StagingBufferPool::StagingBufferPool(const Device& device_, MemoryAllocator& mem
 StagingBufferPool::~StagingBufferPool() = default;
 
 StagingBufferRef StagingBufferPool::Request(size_t size, MemoryUsage usage, bool deferred) {
-    if (!deferred && usage == MemoryUsage::Upload && size <= region_size) {
-        return GetStreamBuffer(size);
-    }
-    return GetStagingBuffer(size, usage, deferred);
+    const auto start_time = std::chrono::steady_clock::now();
+    StagingBufferRef ref = Allocate(size, usage, deferred);
+    const auto elapsed = std::chrono::steady_clock::now() - start_time;
+    const u64 elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    ++num_requests;
+    request_time_ns += elapsed_ns;
+    max_request_time_ns = std::max(max_request_time_ns, elapsed_ns);
+    return ref;
 }
 
 void StagingBufferPool::FreeDeferred(StagingBufferRef& ref) {
@@ -100,13 +138,42 @@ void StagingBufferPool::TickFrame() {
     ReleaseCache(MemoryUsage::DeviceLocal);
     ReleaseCache(MemoryUsage::Upload);
     ReleaseCache(MemoryUsage::Download);
+
+    size_t bytes_in_flight = 0;
+    for (RingBuffer& ring : ring_buffers) {
+        RetireRing(ring);
+        for (const RingAllocation& allocation : ring.in_flight) {
+            bytes_in_flight += allocation.end - allocation.begin;
+        }
+    }
+    if (num_requests != 0) {
+        LOG_DEBUG(Render_Vulkan,
+                  "Staging requests: {} ({} dedicated), {} ns average, {} ns max, "
+                  "{} KiB in flight in {} ring buffers",
+                  num_requests, num_dedicated_requests, request_time_ns / num_requests,
+                  max_request_time_ns, bytes_in_flight / 1_KiB, ring_buffers.size());
+    }
+    num_requests = 0;
+    num_dedicated_requests = 0;
+    request_time_ns = 0;
+    max_request_time_ns = 0;
+}
+
+StagingBufferRef StagingBufferPool::Allocate(size_t size, MemoryUsage usage, bool deferred) {
+    if (deferred || usage != MemoryUsage::Upload) {
+        return GetStagingBuffer(size, usage, deferred);
+    }
+    if (size <= region_size) {
+        return GetStreamBuffer(size);
+    }
+    return GetUploadBuffer(size);
 }
 
 StagingBufferRef StagingBufferPool::GetStreamBuffer(size_t size) {
     if (AreRegionsActive(Region(free_iterator) + 1,
                          std::min(Region(iterator + size) + 1, NUM_SYNCS))) {
         // Avoid waiting for the previous usages to be free
-        return GetStagingBuffer(size, MemoryUsage::Upload);
+        return GetUploadBuffer(size);
     }
     const u64 current_tick = scheduler.CurrentTick();
     std::fill(sync_ticks.begin() + Region(used_iterator), sync_ticks.begin() + Region(iterator),
@@ -123,7 +190,7 @@ StagingBufferRef StagingBufferPool::GetStreamBuffer(size_t size) {
 
         if (AreRegionsActive(0, Region(size) + 1)) {
             // Avoid waiting for the previous usages to be free
-            return GetStagingBuffer(size, MemoryUsage::Upload);
+            return GetUploadBuffer(size);
         }
     }
     const size_t offset = iterator;
@@ -138,6 +205,109 @@ StagingBufferRef StagingBufferPool::GetStreamBuffer(size_t size) {
     };
 }
 
+StagingBufferRef StagingBufferPool::GetUploadBuffer(size_t size) {
+    if (size <= MAX_RING_ALLOCATION_SIZE) {
+        if (const std::optional<StagingBufferRef> ref = TryGetRingBuffer(size)) {
+            return *ref;
+        }
+    }
+    ++num_dedicated_requests;
+    return GetStagingBuffer(size, MemoryUsage::Upload);
+}
+
+std::optional<StagingBufferRef> StagingBufferPool::TryGetRingBuffer(size_t size) {
+    const size_t aligned_size = Common::AlignUp(size, MAX_ALIGNMENT);
+    const auto make_ref = [size](RingBuffer& ring, size_t offset) {
+        return StagingBufferRef{
+            .buffer = *ring.buffer,
+            .offset = static_cast<VkDeviceSize>(offset),
+            .mapped_span = ring.mapped_span.subspan(offset, size),
+            .usage{},
+            .log2_level{},
+            .index{},
+        };
+    };
+    // Start from the ring that served the last request, it is the most likely to have space
+    for (size_t i = 0; i < ring_buffers.size(); ++i) {
+        const size_t index = (ring_index + i) % ring_buffers.size();
+        RingBuffer& ring = ring_buffers[index];
+        RetireRing(ring);
+        if (const std::optional<size_t> offset = TryAllocateRing(ring, aligned_size)) {
+            ring_index = index;
+            return make_ref(ring, *offset);
+        }
+    }
+    if (ring_buffers.size() >= MAX_RING_BUFFERS) {
+        return std::nullopt;
+    }
+    RingBuffer& ring = CreateRingBuffer();
+    ring_index = ring_buffers.size() - 1;
+    return make_ref(ring, *TryAllocateRing(ring, aligned_size));
+}
+
+std::optional<size_t> StagingBufferPool::TryAllocateRing(RingBuffer& ring, size_t size) {
+    size_t offset = 0;
+    if (!ring.in_flight.empty()) {
+        const RingAllocation& front = ring.in_flight.front();
+        const RingAllocation& back = ring.in_flight.back();
+        const bool is_wrapped = back.begin < front.begin;
+        if (!is_wrapped && back.end + size <= RING_BUFFER_SIZE) {
+            offset = back.end;
+        } else if (!is_wrapped && size <= front.begin) {
+            offset = 0;
+        } else if (is_wrapped && back.end + size <= front.begin) {
+            offset = back.end;
+        } else {
+            return std::nullopt;
+        }
+    }
+    const u64 current_tick = scheduler.CurrentTick();
+    if (!ring.in_flight.empty() && ring.in_flight.back().tick == current_tick &&
+        ring.in_flight.back().end == offset) {
+        // Merge contiguous allocations of the same command buffer
+        ring.in_flight.back().end += size;
+    } else {
+        ring.in_flight.push_back({
+            .begin = offset,
+            .end = offset + size,
+            .tick = current_tick,
+        });
+    }
+    return offset;
+}
+
+void StagingBufferPool::RetireRing(RingBuffer& ring) {
+    while (!ring.in_flight.empty() && scheduler.IsFree(ring.in_flight.front().tick)) {
+        ring.in_flight.pop_front();
+    }
+}
+
+StagingBufferPool::RingBuffer& StagingBufferPool::CreateRingBuffer() {
+    VkBufferCreateInfo buffer_ci = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .size = RING_BUFFER_SIZE,
+        .usage = StagingBufferUsage(device),
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+    };
+    std::array<u32, 2> queue_families;
+    ShareWithTransferQueue(device, buffer_ci, queue_families);
+    vk::Buffer buffer = memory_allocator.CreateBuffer(buffer_ci, MemoryUsage::Upload);
+    if (device.HasDebuggingToolAttached()) {
+        buffer.SetObjectNameEXT(fmt::format("Staging Ring {}", ring_buffers.size()).c_str());
+    }
+    const std::span<u8> mapped_span = buffer.Mapped();
+    ASSERT_MSG(!mapped_span.empty(), "Staging ring buffers must be host visible!");
+    return ring_buffers.emplace_back(RingBuffer{
+        .buffer = std::move(buffer),
+        .mapped_span = mapped_span,
+        .in_flight{},
+    });
+}
+
 bool StagingBufferPool::AreRegionsActive(size_t region_begin, size_t region_end) const {
     const u64 gpu_tick = scheduler.GetMasterSemaphore().KnownGpuTick();
     return std::any_of(sync_ticks.begin() + region_begin, sync_ticks.begin() + region_end,
@@ -184,16 +354,13 @@ StagingBufferRef StagingBufferPool::CreateStagingBuffer(size_t size, MemoryUsage
         .pNext = nullptr,
         .flags = 0,
         .size = 1ULL << log2,
-        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
-                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        .usage = StagingBufferUsage(device),
         .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
         .queueFamilyIndexCount = 0,
         .pQueueFamilyIndices = nullptr,
     };
-    if (device.IsExtTransformFeedbackSupported()) {
-        buffer_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
-    }
+    std::array<u32, 2> queue_families;
+    ShareWithTransferQueue(device, buffer_ci, queue_families);
     vk::Buffer buffer = memory_allocator.CreateBuffer(buffer_ci, usage);
     if (device.HasDebuggingToolAttached()) {
         ++buffer_index;
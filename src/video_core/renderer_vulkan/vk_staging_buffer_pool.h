@@ -4,6 +4,8 @@
 #pragma once
 
 #include <climits>
+#include <deque>
+#include <optional>
 #include <vector>
 
 #include "common/common_types.h"
@@ -75,11 +77,38 @@ private:
         size_t iterate_index = 0;
     };
 
+    /// Range of a ring buffer used by the command buffer of a tick
+    struct RingAllocation {
+        size_t begin;
+        size_t end;
+        u64 tick;
+    };
+
+    /// Persistently mapped upload buffer suballocated in order, ranges are retired in order as
+    /// the master semaphore signals their ticks
+    struct RingBuffer {
+        vk::Buffer buffer;
+        std::span<u8> mapped_span;
+        std::deque<RingAllocation> in_flight;
+    };
+
     static constexpr size_t NUM_LEVELS = sizeof(size_t) * CHAR_BIT;
     using StagingBuffersCache = std::array<StagingBuffers, NUM_LEVELS>;
 
+    StagingBufferRef Allocate(size_t size, MemoryUsage usage, bool deferred);
+
     StagingBufferRef GetStreamBuffer(size_t size);
 
+    StagingBufferRef GetUploadBuffer(size_t size);
+
+    std::optional<StagingBufferRef> TryGetRingBuffer(size_t size);
+
+    std::optional<size_t> TryAllocateRing(RingBuffer& ring, size_t size);
+
+    void RetireRing(RingBuffer& ring);
+
+    RingBuffer& CreateRingBuffer();
+
     bool AreRegionsActive(size_t region_begin, size_t region_end) const;
 
     StagingBufferRef GetStagingBuffer(size_t size, MemoryUsage usage, bool deferred = false);
@@ -112,6 +141,9 @@ private:
     size_t free_iterator = 0;
     std::array<u64, NUM_SYNCS> sync_ticks{};
 
+    std::vector<RingBuffer> ring_buffers;
+    size_t ring_index = 0;
+
     StagingBuffersCache device_local_cache;
     StagingBuffersCache upload_cache;
     StagingBuffersCache download_cache;
@@ -119,6 +151,12 @@ private:
     size_t current_delete_level = 0;
     u64 buffer_index = 0;
     u64 unique_ids{};
+
+    // Statistics of the current frame
+    u64 num_requests{};
+    u64 num_dedicated_requests{};
+    u64 request_time_ns{};
+    u64 max_request_time_ns{};
 };
 
 } // namespace Vulkan
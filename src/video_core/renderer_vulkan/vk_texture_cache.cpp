@@ -9,6 +9,7 @@
 
 #include "common/bit_cast.h"
 #include "common/bit_util.h"
+#include "common/literals.h"
 #include "common/settings.h"
 
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
@@ -20,6 +21,7 @@
 #include "video_core/renderer_vulkan/vk_render_pass_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
+#include "video_core/renderer_vulkan/vk_transfer_queue.h"
 #include "video_core/texture_cache/formatter.h"
 #include "video_core/texture_cache/samples_helper.h"
 #include "video_core/texture_cache/util.h"
@@ -557,6 +559,32 @@ void CopyBufferToImage(vk::CommandBuffer cmdbuf, VkBuffer src_buffer, VkImage im
                            write_barrier);
 }
 
+/// Transfers the ownership of an image written by the transfer queue to the graphics queue
+/// family, the same barrier has to be recorded on both queues
+[[nodiscard]] VkImageMemoryBarrier MakeOwnershipTransferBarrier(VkImage image,
+                                                                VkImageAspectFlags aspect_mask,
+                                                                u32 transfer_family,
+                                                                u32 graphics_family) {
+    return VkImageMemoryBarrier{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = 0,
+        .dstAccessMask = 0,
+        .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .srcQueueFamilyIndex = transfer_family,
+        .dstQueueFamilyIndex = graphics_family,
+        .image = image,
+        .subresourceRange{
+            .aspectMask = aspect_mask,
+            .baseMipLevel = 0,
+            .levelCount = VK_REMAINING_MIP_LEVELS,
+            .baseArrayLayer = 0,
+            .layerCount = VK_REMAINING_ARRAY_LAYERS,
+        },
+    };
+}
+
 [[nodiscard]] VkImageBlit MakeImageBlit(const Region2D& dst_region, const Region2D& src_region,
                                         const VkImageSubresourceLayers& dst_layers,
                                         const VkImageSubresourceLayers& src_layers) {
@@ -1436,9 +1464,81 @@ void Image::UploadMemory(VkBuffer buffer, VkDeviceSize offset,
 }
 
 void Image::UploadMemory(const StagingBufferRef& map, std::span<const BufferImageCopy> copies) {
+    if (TryUploadMemoryAsync(map, copies)) {
+        return;
+    }
     UploadMemory(map.buffer, map.offset, copies);
 }
 
+bool Image::TryUploadMemoryAsync(const StagingBufferRef& map,
+                                 std::span<const BufferImageCopy> copies) {
+    using namespace Common::Literals;
+    // Smaller uploads are cheaper to record inline than to synchronize with the transfer queue
+    static constexpr size_t MIN_ASYNC_UPLOAD_SIZE = 256_KiB;
+
+    TransferQueue* const transfer_queue = scheduler->GetTransferQueue();
+    // Only images without contents can skip releasing them from the graphics queue, and transfer
+    // queues can't copy to depth or stencil aspects
+    if (!transfer_queue || initialized || aspect_mask != VK_IMAGE_ASPECT_COLOR_BIT ||
+        True(flags & ImageFlagBits::Rescaled) || map.mapped_span.size() < MIN_ASYNC_UPLOAD_SIZE) {
+        return false;
+    }
+    const auto vk_copies = TransformBufferImageCopies(copies, map.offset, aspect_mask);
+    const auto is_unaligned = [](const VkBufferImageCopy& copy) {
+        return copy.bufferOffset % 4 != 0;
+    };
+    if (std::ranges::any_of(vk_copies, is_unaligned)) {
+        return false;
+    }
+    initialized = true;
+
+    const VkImage vk_image = *original_image;
+    const VkImageMemoryBarrier transfer_barrier{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = 0,
+        .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = vk_image,
+        .subresourceRange{
+            .aspectMask = aspect_mask,
+            .baseMipLevel = 0,
+            .levelCount = VK_REMAINING_MIP_LEVELS,
+            .baseArrayLayer = 0,
+            .layerCount = VK_REMAINING_ARRAY_LAYERS,
+        },
+    };
+    VkImageMemoryBarrier release_barrier = MakeOwnershipTransferBarrier(
+        vk_image, aspect_mask, transfer_queue->Family(), runtime->device.GetGraphicsFamily());
+    release_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    const vk::CommandBuffer cmdbuf = transfer_queue->CommandBuffer();
+    cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                           transfer_barrier);
+    cmdbuf.CopyBufferToImage(map.buffer, vk_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                             vk_copies);
+    cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                           0, release_barrier);
+    transfer_queue->AddPendingBytes(map.mapped_span.size());
+
+    // The graphics submission recording the acquire waits for the transfer queue
+    VkImageMemoryBarrier acquire_barrier = MakeOwnershipTransferBarrier(
+        vk_image, aspect_mask, transfer_queue->Family(), runtime->device.GetGraphicsFamily());
+    acquire_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+                                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                                    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                    VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    scheduler->RequestOutsideRenderPassOperationContext();
+    scheduler->Record([acquire_barrier](vk::CommandBuffer graphics_cmdbuf) {
+        graphics_cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, acquire_barrier);
+    });
+    return true;
+}
+
 void Image::DownloadMemory(VkBuffer buffer, size_t offset,
                            std::span<const VideoCommon::BufferImageCopy> copies) {
     std::array buffer_handles{
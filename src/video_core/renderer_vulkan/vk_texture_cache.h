@@ -180,6 +180,11 @@ public:
 private:
     bool BlitScaleHelper(bool scale_up);
 
+    /// Uploads the first contents of the image on the transfer queue, returns false when the
+    /// upload has to be recorded on the graphics queue
+    bool TryUploadMemoryAsync(const StagingBufferRef& map,
+                              std::span<const VideoCommon::BufferImageCopy> copies);
+
     bool NeedsScaleHelper() const;
 
     Scheduler* scheduler{};
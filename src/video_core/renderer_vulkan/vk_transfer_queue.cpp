@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+
+#include "common/literals.h"
+#include "video_core/renderer_vulkan/vk_master_semaphore.h"
+#include "video_core/renderer_vulkan/vk_transfer_queue.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+namespace {
+
+using namespace Common::Literals;
+
+// Pending uploads are submitted before the graphics submission when they reach this size
+constexpr size_t EARLY_SUBMIT_THRESHOLD = 8_MiB;
+
+} // Anonymous namespace
+
+TransferQueue::TransferQueue(const Device& device_, MasterSemaphore& master_semaphore)
+    : device{device_}, command_pool{master_semaphore, device, device.GetTransferFamily()} {
+    static constexpr VkSemaphoreTypeCreateInfo semaphore_type_ci{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .pNext = nullptr,
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue = 0,
+    };
+    static constexpr VkSemaphoreCreateInfo semaphore_ci{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = &semaphore_type_ci,
+        .flags = 0,
+    };
+    semaphore = device.GetLogical().CreateSemaphore(semaphore_ci);
+    if (device.HasDebuggingToolAttached()) {
+        semaphore.SetObjectNameEXT("Transfer Queue Timeline");
+    }
+}
+
+TransferQueue::~TransferQueue() = default;
+
+vk::CommandBuffer TransferQueue::CommandBuffer() {
+    if (!is_recording) {
+        // The command buffer is committed with the tick of the graphics submission waiting for it
+        cmdbuf = vk::CommandBuffer(command_pool.Commit(), device.GetDispatchLoader());
+        cmdbuf.Begin({
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .pNext = nullptr,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            .pInheritanceInfo = nullptr,
+        });
+        is_recording = true;
+    }
+    return cmdbuf;
+}
+
+void TransferQueue::AddPendingBytes(size_t bytes) {
+    pending_bytes += bytes;
+    if (pending_bytes >= EARLY_SUBMIT_THRESHOLD) {
+        // Start the copies while the graphics queue is still busy with previous submissions
+        Submit();
+    }
+}
+
+u64 TransferQueue::Flush() {
+    if (is_recording) {
+        Submit();
+    }
+    return std::exchange(wait_value, 0);
+}
+
+u32 TransferQueue::Family() const noexcept {
+    return device.GetTransferFamily();
+}
+
+void TransferQueue::Submit() {
+    cmdbuf.End();
+
+    const u64 signal_value = ++current_value;
+    const VkSemaphore signal_semaphore = *semaphore;
+    const VkCommandBuffer handle = *cmdbuf;
+    const VkTimelineSemaphoreSubmitInfo timeline_si{
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .pNext = nullptr,
+        .waitSemaphoreValueCount = 0,
+        .pWaitSemaphoreValues = nullptr,
+        .signalSemaphoreValueCount = 1,
+        .pSignalSemaphoreValues = &signal_value,
+    };
+    const VkSubmitInfo submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .pNext = &timeline_si,
+        .waitSemaphoreCount = 0,
+        .pWaitSemaphores = nullptr,
+        .pWaitDstStageMask = nullptr,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &handle,
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = &signal_semaphore,
+    };
+    switch (const VkResult result = device.GetTransferQueue().Submit(submit_info)) {
+    case VK_SUCCESS:
+        break;
+    case VK_ERROR_DEVICE_LOST:
+        device.ReportLoss();
+        [[fallthrough]];
+    default:
+        vk::Check(result);
+        break;
+    }
+    is_recording = false;
+    pending_bytes = 0;
+    wait_value = signal_value;
+}
+
+} // namespace Vulkan
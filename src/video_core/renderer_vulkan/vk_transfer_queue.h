@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/common_types.h"
+#include "video_core/renderer_vulkan/vk_command_pool.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+class MasterSemaphore;
+
+/// Records uploads submitted to the dedicated transfer queue of the device.
+/// Resources written here are released to the graphics queue family, graphics submissions
+/// acquiring them wait for the timeline value returned by Flush.
+/// Command buffers are retired with the master semaphore tick of the graphics submission that
+/// waits for them.
+class TransferQueue {
+public:
+    explicit TransferQueue(const Device& device, MasterSemaphore& master_semaphore);
+    ~TransferQueue();
+
+    TransferQueue& operator=(const TransferQueue&) = delete;
+    TransferQueue(const TransferQueue&) = delete;
+
+    /// Returns the command buffer of the next transfer submission, beginning it if needed.
+    vk::CommandBuffer CommandBuffer();
+
+    /// Accounts recorded upload bytes, submitting them early when enough work is pending.
+    void AddPendingBytes(size_t bytes);
+
+    /// Submits the pending uploads and returns the timeline value the next graphics submission
+    /// has to wait for, or zero when nothing was uploaded since the last graphics submission.
+    [[nodiscard]] u64 Flush();
+
+    /// Returns the timeline semaphore signaled by transfer submissions.
+    [[nodiscard]] VkSemaphore Semaphore() const noexcept {
+        return *semaphore;
+    }
+
+    /// Returns the queue family index of the transfer queue.
+    [[nodiscard]] u32 Family() const noexcept;
+
+private:
+    void Submit();
+
+    const Device& device;
+    CommandPool command_pool;
+    vk::Semaphore semaphore;
+    vk::CommandBuffer cmdbuf;
+    bool is_recording = false;
+    size_t pending_bytes = 0;
+    u64 current_value = 0;
+    u64 wait_value = 0;
+};
+
+} // namespace Vulkan
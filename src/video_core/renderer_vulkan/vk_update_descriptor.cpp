@@ -26,6 +26,14 @@ void UpdateDescriptorQueue::TickFrame() {
     }
     payload_start = payload.data() + frame_index * FRAME_PAYLOAD_SIZE;
     payload_cursor = payload_start;
+
+    const u64 pushed = pushed_descriptors.exchange(0, std::memory_order_relaxed);
+    const u64 updated = updated_descriptors.exchange(0, std::memory_order_relaxed);
+    const u64 reused = reused_descriptors.exchange(0, std::memory_order_relaxed);
+    if (pushed != 0 || updated != 0 || reused != 0) {
+        LOG_DEBUG(Render_Vulkan, "Descriptor writes: {} pushed, {} updated, {} skipped by reuse",
+                  pushed, updated, reused);
+    }
 }
 
 void UpdateDescriptorQueue::Acquire() {
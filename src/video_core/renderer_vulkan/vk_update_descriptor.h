@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -75,6 +76,21 @@ public:
         *(payload_cursor++) = texel_buffer;
     }
 
+    /// Counts descriptors written with push descriptors, reported once per frame
+    void CountPushed(u32 num_descriptors) noexcept {
+        pushed_descriptors.fetch_add(num_descriptors, std::memory_order_relaxed);
+    }
+
+    /// Counts descriptors written to descriptor sets, reported once per frame
+    void CountUpdated(u32 num_descriptors) noexcept {
+        updated_descriptors.fetch_add(num_descriptors, std::memory_order_relaxed);
+    }
+
+    /// Counts descriptor writes skipped by reusing a descriptor set, reported once per frame
+    void CountReused(u32 num_descriptors) noexcept {
+        reused_descriptors.fetch_add(num_descriptors, std::memory_order_relaxed);
+    }
+
 private:
     const Device& device;
     Scheduler& scheduler;
@@ -84,6 +100,10 @@ private:
     DescriptorUpdateEntry* payload_start = nullptr;
     const DescriptorUpdateEntry* upload_start = nullptr;
     std::array<DescriptorUpdateEntry, PAYLOAD_SIZE> payload;
+
+    std::atomic<u64> pushed_descriptors{};
+    std::atomic<u64> updated_descriptors{};
+    std::atomic<u64> reused_descriptors{};
 };
 
 // TODO: should these be separate classes instead?
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <fstream>
+
+#include "common/container_hash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "shader_recompiler/frontend/ir/serialization.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "video_core/shader_ir_cache.h"
+
+namespace VideoCommon {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'i', 'r', 'c', 'h'};
+
+struct Header {
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    u32 program_version;
+    u64 host_key;
+
+    [[nodiscard]] bool operator==(const Header&) const = default;
+};
+static_assert(std::has_unique_object_representations_v<Header>);
+
+u64 HostKey(const Shader::HostTranslateInfo& info) {
+    // Every member has to be hashed, cached programs depend on all of them
+    return Common::HashValue(std::array<u32, 10>{
+        info.support_float64,
+        info.support_float16,
+        info.support_int64,
+        info.needs_demote_reorder,
+        info.support_snorm_render_buffer,
+        info.support_viewport_index_layer,
+        info.min_ssbo_alignment,
+        info.support_geometry_shader_passthrough,
+        info.support_conditional_barrier,
+        info.enable_global_optimizations,
+    });
+}
+
+u64 ProgramKey(u64 pipeline_hash, u32 stage) {
+    size_t key{pipeline_hash};
+    Common::HashCombine(key, stage);
+    return key;
+}
+
+void RemoveCacheFile(const std::filesystem::path& filename) {
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete shader IR cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+} // Anonymous namespace
+
+void ShaderIRCache::Load(const std::filesystem::path& filename_, u32 cache_version_,
+                         const Shader::HostTranslateInfo& host_info) try {
+    filename = filename_;
+    cache_version = cache_version_;
+    host_key = HostKey(host_info);
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{file.tellg()};
+    file.seekg(0, std::ios::beg);
+
+    const Header expected_header{MAGIC_NUMBER, cache_version,
+                                 Shader::IR::SERIALIZED_PROGRAM_VERSION, host_key};
+    Header header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (header != expected_header) {
+        // Programs translated for another host or IR revision can't be reused
+        file.close();
+        LOG_INFO(Common_Filesystem, "Deleting outdated shader IR cache");
+        RemoveCacheFile(filename);
+        return;
+    }
+    while (file.tellg() != end) {
+        u64 key{};
+        u32 size{};
+        file.read(reinterpret_cast<char*>(&key), sizeof(key))
+            .read(reinterpret_cast<char*>(&size), sizeof(size));
+        std::vector<u8> program(size);
+        file.read(reinterpret_cast<char*>(program.data()), size);
+        programs.insert_or_assign(key, std::move(program));
+    }
+    LOG_INFO(Common_Filesystem, "Loaded {} cached shader programs", programs.size());
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    programs.clear();
+    RemoveCacheFile(filename);
+}
+
+const std::vector<u8>* ShaderIRCache::Find(u64 pipeline_hash, u32 stage) const {
+    const auto it{programs.find(ProgramKey(pipeline_hash, stage))};
+    return it != programs.end() ? &it->second : nullptr;
+}
+
+void ShaderIRCache::Save(u64 pipeline_hash, u32 stage, std::span<const u8> program) try {
+    if (filename.empty() || program.empty()) {
+        return;
+    }
+    std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
+    file.exceptions(std::ifstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open shader IR cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    if (file.tellp() == 0) {
+        const Header header{MAGIC_NUMBER, cache_version, Shader::IR::SERIALIZED_PROGRAM_VERSION,
+                            host_key};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    const u64 key{ProgramKey(pipeline_hash, stage)};
+    const u32 size{static_cast<u32>(program.size())};
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key))
+        .write(reinterpret_cast<const char*>(&size), sizeof(size))
+        .write(reinterpret_cast<const char*>(program.data()), size);
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    RemoveCacheFile(filename);
+}
+
+void ShaderIRCache::ReleaseLoaded() {
+    programs.clear();
+    programs.rehash(0);
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Shader {
+struct HostTranslateInfo;
+}
+
+namespace VideoCommon {
+
+/// Disk cache of translated shader programs, stored next to the pipeline cache.
+/// Pipelines loaded from disk use it to skip the translation passes that only depend on the guest
+/// shader, running only the profile dependent passes and the backend emission.
+class ShaderIRCache {
+public:
+    /// Loads the programs of a cache file, the file is discarded when it was written by a
+    /// different cache version or with different host translation info
+    void Load(const std::filesystem::path& filename, u32 cache_version,
+              const Shader::HostTranslateInfo& host_info);
+
+    /// Returns the serialized program of a pipeline stage, or nullptr when it isn't cached
+    [[nodiscard]] const std::vector<u8>* Find(u64 pipeline_hash, u32 stage) const;
+
+    /// Appends a serialized program to the cache file
+    void Save(u64 pipeline_hash, u32 stage, std::span<const u8> program);
+
+    /// Releases the programs loaded from disk, once the pipelines using them have been built
+    void ReleaseLoaded();
+
+    [[nodiscard]] bool IsEnabled() const noexcept {
+        return !filename.empty();
+    }
+
+private:
+    std::filesystem::path filename;
+    u32 cache_version{};
+    u64 host_key{};
+    std::unordered_map<u64, std::vector<u8>> programs;
+};
+
+} // namespace VideoCommon
@@ -729,6 +729,9 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
 
     graphics_queue = logical.GetQueue(graphics_family);
     present_queue = logical.GetQueue(present_family);
+    if (has_transfer_queue) {
+        transfer_queue = logical.GetQueue(transfer_family);
+    }
 
     VmaVulkanFunctions functions{};
     functions.vkGetInstanceProcAddr = dld.vkGetInstanceProcAddr;
@@ -1104,6 +1107,11 @@ bool Device::GetSuitability(bool requires_swapchain) {
             VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TRANSFORM_FEEDBACK_PROPERTIES_EXT;
         SetNext(next, properties.transform_feedback);
     }
+    if (extensions.graphics_pipeline_library) {
+        properties.graphics_pipeline_library.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+        SetNext(next, properties.graphics_pipeline_library);
+    }
 
     // Perform the property fetch.
     physical.GetProperties2(properties2);
@@ -1225,6 +1233,24 @@ void Device::RemoveUnsuitableExtensions() {
     RemoveExtensionFeatureIfUnsuitable(extensions.transform_feedback, features.transform_feedback,
                                        VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME);
 
+    // VK_EXT_graphics_pipeline_library
+    if (Settings::values.use_graphics_pipeline_library.GetValue()) {
+        extensions.graphics_pipeline_library =
+            extensions.pipeline_library &&
+            features.graphics_pipeline_library.graphicsPipelineLibrary &&
+            properties.graphics_pipeline_library.graphicsPipelineLibraryFastLinking;
+        RemoveExtensionFeatureIfUnsuitable(extensions.graphics_pipeline_library,
+                                           features.graphics_pipeline_library,
+                                           VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    } else {
+        RemoveExtensionFeature(extensions.graphics_pipeline_library,
+                               features.graphics_pipeline_library,
+                               VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    }
+    if (!extensions.graphics_pipeline_library) {
+        RemoveExtension(extensions.pipeline_library, VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+    }
+
     // VK_EXT_vertex_input_dynamic_state
     extensions.vertex_input_dynamic_state =
         features.vertex_input_dynamic_state.vertexInputDynamicState;
@@ -1290,6 +1316,24 @@ void Device::SetupFamilies(VkSurfaceKHR surface) {
     if (present) {
         present_family = *present;
     }
+    if (!Settings::values.use_async_transfer_queue.GetValue()) {
+        return;
+    }
+    for (u32 index = 0; index < static_cast<u32>(queue_family_properties.size()); ++index) {
+        const VkQueueFamilyProperties& queue_family = queue_family_properties[index];
+        const VkQueueFlags flags = queue_family.queueFlags;
+        const VkExtent3D& granularity = queue_family.minImageTransferGranularity;
+        const bool is_dedicated = (flags & VK_QUEUE_TRANSFER_BIT) != 0 &&
+                                  (flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0;
+        // Partial mip levels can't be copied with a coarser granularity
+        const bool is_fine_grained =
+            granularity.width == 1 && granularity.height == 1 && granularity.depth == 1;
+        if (queue_family.queueCount != 0 && is_dedicated && is_fine_grained) {
+            transfer_family = index;
+            has_transfer_queue = true;
+            break;
+        }
+    }
 }
 
 u64 Device::GetDeviceMemoryUsage() const {
@@ -1368,6 +1412,9 @@ std::vector<VkDeviceQueueCreateInfo> Device::GetDeviceQueueCreateInfos() const {
     static constexpr float QUEUE_PRIORITY = 1.0f;
 
     std::unordered_set<u32> unique_queue_families{graphics_family, present_family};
+    if (has_transfer_queue) {
+        unique_queue_families.insert(transfer_family);
+    }
     std::vector<VkDeviceQueueCreateInfo> queue_cis;
     queue_cis.reserve(unique_queue_families.size());
 
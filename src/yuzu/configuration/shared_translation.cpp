@@ -221,6 +221,14 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
               "unlocked."));
     INSERT(Settings, barrier_feedback_loops, tr("Barrier feedback loops"),
            tr("Improves rendering of transparency effects in specific games."));
+    INSERT(Settings, use_async_transfer_queue, tr("Upload textures asynchronously (Vulkan only)"),
+           tr("Uploads large textures on a dedicated transfer queue when the GPU has one, "
+              "overlapping them with rendering."));
+    INSERT(Settings, use_graphics_pipeline_library,
+           tr("Use graphics pipeline libraries (Vulkan only)"),
+           tr("Links new pipelines from precompiled shader libraries and builds the optimized "
+              "pipeline in the background.\nReduces stutter when the driver supports fast "
+              "linking."));
 
     // Renderer (Debug)
 
@@ -1049,9 +1049,14 @@ void GMainWindow::InitializeWidgets() {
     emu_frametime_label->setToolTip(
         tr("Time taken to emulate a Switch frame, not counting framelimiting or v-sync. For "
            "full-speed emulation this should be at most 16.67 ms."));
+    emu_memory_label = new QLabel();
+    emu_memory_label->setToolTip(
+        tr("Emulated physical memory committed by the host, out of the memory reserved for it. "
+           "This is estimated from the memory released by the game on hosts that can't report "
+           "it. Memory freed by the game is returned to the system."));
 
     for (auto& label : {shader_building_label, res_scale_label, emu_speed_label, game_fps_label,
-                        emu_frametime_label}) {
+                        emu_frametime_label, emu_memory_label}) {
         label->setVisible(false);
         label->setFrameStyle(QFrame::NoFrame);
         label->setContentsMargins(4, 0, 4, 0);
@@ -2190,6 +2195,7 @@ void GMainWindow::OnEmulationStopped() {
     emu_speed_label->setVisible(false);
     game_fps_label->setVisible(false);
     emu_frametime_label->setVisible(false);
+    emu_memory_label->setVisible(false);
     renderer_status_button->setEnabled(!UISettings::values.has_broken_vulkan);
 
     if (!firmware_label->text().isEmpty()) {
@@ -4663,11 +4669,15 @@ void GMainWindow::UpdateStatusBar() {
             tr("Game: %1 FPS").arg(std::round(results.average_game_fps), 0, 'f', 0));
     }
     emu_frametime_label->setText(tr("Frame: %1 ms").arg(results.frametime * 1000.0, 0, 'f', 2));
+    emu_memory_label->setText(tr("Memory: %1 / %2 MiB")
+                                  .arg(results.committed_memory / 1_MiB)
+                                  .arg(results.reserved_memory / 1_MiB));
 
     res_scale_label->setVisible(true);
     emu_speed_label->setVisible(!Settings::values.use_multi_core.GetValue());
     game_fps_label->setVisible(true);
     emu_frametime_label->setVisible(true);
+    emu_memory_label->setVisible(true);
     firmware_label->setVisible(false);
 }
 
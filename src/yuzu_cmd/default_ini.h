@@ -304,6 +304,10 @@ nsight_aftermath =
 # 0 (default): Disabled, 1: Enabled
 disable_shader_loop_safety_checks =
 
+# Run sparse conditional constant propagation and global value numbering on shaders
+# 0 (default): Disabled, 1: Enabled
+shader_global_optimizations =
+
 # Which Vulkan physical device to use (defaults to 0)
 vulkan_device =
 